@@ -18,6 +18,7 @@
 /*
  * OMG PSM class declaration
  */
+#include <utility>
 #include <dds/core/Value.hpp>
 
 // Implementation
@@ -78,7 +79,7 @@ Value<D>& Value<D>::operator=(Value&& other)
 {
     if(this != &other)
     {
-        d_ = other.d_;
+        d_ = std::move(other.d_);
     }
     return *this;
 }
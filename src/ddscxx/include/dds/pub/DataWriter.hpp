@@ -486,6 +486,12 @@ public:
      * A TopicInstance encapsulates a typed Sample and its associated
      * @ref anchor_dds_pub_datawriter_write_instance_handle "instance handle".
      *
+     * <i>Partial writes</i><br>
+     * All samples are serialized before the first one is written, so nothing is
+     * written if one of them cannot be serialized. If writing a sample fails, the
+     * samples before it have been written and the others have not. The message of
+     * the exception states how many samples were written.
+     *
      * <i>Blocking</i><br>
      * This operation can be blocked (see @ref anchor_dds_pub_datawriter_write_blocking "write blocking").
      *
@@ -25,7 +25,9 @@
 #include <org/eclipse/cyclonedds/topic/TopicTraits.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/SerializedSample.hpp>
 #include <dds/dds.h>
+#include <vector>
 
 namespace dds {
     namespace pub {
@@ -76,6 +78,12 @@ public:
 
     void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample, const dds::core::Time& timestamp);
 
+    void write_cdr(std::vector<uint8_t>&& serialized);
+
+    void write_cdr(std::vector<uint8_t>&& serialized, const dds::core::Time& timestamp);
+
+    void write_serialized(const org::eclipse::cyclonedds::pub::SerializedSample<T>& sample);
+
     void dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample);
 
     void dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample, const dds::core::Time& timestamp);
@@ -99,6 +107,26 @@ public:
     void write(const dds::topic::TopicInstance<T>& i,
                const dds::core::Time& timestamp);
 
+    template <typename FWIterator>
+    void write(const FWIterator& begin, const FWIterator& end);
+
+    template <typename FWIterator>
+    void write(const FWIterator& begin, const FWIterator& end,
+               const dds::core::Time& timestamp);
+
+    template <typename SamplesFWIterator, typename HandlesFWIterator>
+    void write(const SamplesFWIterator& data_begin,
+               const SamplesFWIterator& data_end,
+               const HandlesFWIterator& handle_begin,
+               const HandlesFWIterator& handle_end);
+
+    template <typename SamplesFWIterator, typename HandlesFWIterator>
+    void write(const SamplesFWIterator& data_begin,
+               const SamplesFWIterator& data_end,
+               const HandlesFWIterator& handle_begin,
+               const HandlesFWIterator& handle_end,
+               const dds::core::Time& timestamp);
+
     void writedispose(const T& sample);
 
     void writedispose(const T& sample, const dds::core::Time& timestamp);
@@ -182,6 +210,24 @@ public:
           org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate &sd);
 
 private:
+   /* The samples are serialized while iterating over them, as an iterator may
+    * return them by value, not only by reference. */
+   template <typename FWIterator>
+   void collect_samples(const FWIterator& begin,
+                        const FWIterator& end,
+                        SerializedBatch& batch);
+
+   template <typename SamplesFWIterator, typename HandlesFWIterator>
+   void collect_samples(const SamplesFWIterator& data_begin,
+                        const SamplesFWIterator& data_end,
+                        const HandlesFWIterator& handle_begin,
+                        const HandlesFWIterator& handle_end,
+                        SerializedBatch& batch);
+
+   void write_samples(SerializedBatch& batch,
+                      const dds::core::Time& timestamp,
+                      bool dispose);
+
    dds::pub::Publisher                    pub_;
    dds::topic::Topic<T>                   topic_;
 };
@@ -30,6 +30,7 @@
 #include <dds/domain/DomainParticipantListener.hpp>
 #include <org/eclipse/cyclonedds/core/ListenerDispatcher.hpp>
 #include <org/eclipse/cyclonedds/core/NoopListener.hpp>
+#include <org/eclipse/cyclonedds/topic/datatopic.hpp>
 
 namespace dds
 {
@@ -110,12 +111,7 @@ template <typename FWIterator>
 void
 DataWriter<T, DELEGATE>::write(const FWIterator& begin, const FWIterator& end)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->delegate()->write(*b);
-        ++b;
-    }
+    this->delegate()->write(begin, end);
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -124,12 +120,7 @@ void
 DataWriter<T, DELEGATE>::write(const FWIterator& begin, const FWIterator& end,
         const dds::core::Time& timestamp)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->delegate()->write(*b, timestamp);
-        ++b;
-    }
+    this->delegate()->write(begin, end, timestamp);
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -140,15 +131,7 @@ DataWriter<T, DELEGATE>::write(const SamplesFWIterator& data_begin,
         const HandlesFWIterator& handle_begin,
         const HandlesFWIterator& handle_end)
 {
-    SamplesFWIterator data = data_begin;
-    HandlesFWIterator handle = handle_begin;
-
-    while(data != data_end && handle != handle_end)
-    {
-        this->delegate()->write(*data, *handle);
-        ++data;
-        ++handle;
-    }
+    this->delegate()->write(data_begin, data_end, handle_begin, handle_end);
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -160,15 +143,7 @@ DataWriter<T, DELEGATE>::write(const SamplesFWIterator& data_begin,
         const HandlesFWIterator& handle_end,
         const dds::core::Time& timestamp)
 {
-    SamplesFWIterator data = data_begin;
-    HandlesFWIterator handle = handle_begin;
-
-    while(data != data_end && handle != handle_end)
-    {
-        this->delegate()->write(*data, *handle, timestamp);
-        ++data;
-        ++handle;
-    }
+    this->delegate()->write(data_begin, data_end, handle_begin, handle_end, timestamp);
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -473,6 +448,35 @@ dds::pub::detail::DataWriter<T>::write_cdr(
                                   timestamp);
 }
 
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_cdr(std::vector<uint8_t>&& serialized)
+{
+    this->write_cdr(std::move(serialized), dds::core::Time::invalid());
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_cdr(
+            std::vector<uint8_t>&& serialized,
+            const dds::core::Time& timestamp)
+{
+    this->check();
+    AnyDataWriterDelegate::write_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  serdata_from_ser_adopt<T>(this->topic_->get_ser_type(), SDK_DATA, std::move(serialized)),
+                                  timestamp);
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_serialized(
+            const org::eclipse::cyclonedds::pub::SerializedSample<T>& sample)
+{
+    this->check();
+    AnyDataWriterDelegate::write_serialized(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  sample.serdata());
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample)
@@ -667,17 +671,69 @@ dds::pub::detail::DataWriter<T>::writedispose(
                                   timestamp);
 }
 
+template <typename T>
+template <typename FWIterator>
+void
+dds::pub::detail::DataWriter<T>::write(const FWIterator& begin, const FWIterator& end)
+{
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(begin, end, batch);
+    this->write_samples(batch, dds::core::Time::invalid(), false);
+}
+
+template <typename T>
+template <typename FWIterator>
+void
+dds::pub::detail::DataWriter<T>::write(const FWIterator& begin, const FWIterator& end,
+        const dds::core::Time& timestamp)
+{
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(begin, end, batch);
+    this->write_samples(batch, timestamp, false);
+}
+
+template <typename T>
+template <typename SamplesFWIterator, typename HandlesFWIterator>
+void
+dds::pub::detail::DataWriter<T>::write(
+        const SamplesFWIterator& data_begin,
+        const SamplesFWIterator& data_end,
+        const HandlesFWIterator& handle_begin,
+        const HandlesFWIterator& handle_end)
+{
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(data_begin, data_end, handle_begin, handle_end, batch);
+    this->write_samples(batch, dds::core::Time::invalid(), false);
+}
+
+template <typename T>
+template <typename SamplesFWIterator, typename HandlesFWIterator>
+void
+dds::pub::detail::DataWriter<T>::write(
+        const SamplesFWIterator& data_begin,
+        const SamplesFWIterator& data_end,
+        const HandlesFWIterator& handle_begin,
+        const HandlesFWIterator& handle_end,
+        const dds::core::Time& timestamp)
+{
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(data_begin, data_end, handle_begin, handle_end, batch);
+    this->write_samples(batch, timestamp, false);
+}
+
 template <typename T>
 template <typename FWIterator>
 void
 dds::pub::detail::DataWriter<T>::writedispose(const FWIterator& begin, const FWIterator& end)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->writedispose(*b);
-        ++b;
-    }
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(begin, end, batch);
+    this->write_samples(batch, dds::core::Time::invalid(), true);
 }
 
 template <typename T>
@@ -686,12 +742,10 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const FWIterator& begin, const FWIterator& end,
         const dds::core::Time& timestamp)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->writedispose(*b, timestamp);
-        ++b;
-    }
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(begin, end, batch);
+    this->write_samples(batch, timestamp, true);
 }
 
 template <typename T>
@@ -703,15 +757,10 @@ dds::pub::detail::DataWriter<T>::writedispose(
         const HandlesFWIterator& handle_begin,
         const HandlesFWIterator& handle_end)
 {
-    SamplesFWIterator data = data_begin;
-    HandlesFWIterator handle = handle_begin;
-
-    while(data != data_end && handle != handle_end)
-    {
-        this->writedispose(*data, *handle);
-        ++data;
-        ++handle;
-    }
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(data_begin, data_end, handle_begin, handle_end, batch);
+    this->write_samples(batch, dds::core::Time::invalid(), true);
 }
 
 template <typename T>
@@ -724,14 +773,64 @@ dds::pub::detail::DataWriter<T>::writedispose(
         const HandlesFWIterator& handle_end,
         const dds::core::Time& timestamp)
 {
+    this->check();
+    SerializedBatch batch;
+    this->collect_samples(data_begin, data_end, handle_begin, handle_end, batch);
+    this->write_samples(batch, timestamp, true);
+}
+
+template <typename T>
+template <typename FWIterator>
+void
+dds::pub::detail::DataWriter<T>::collect_samples(
+        const FWIterator& begin,
+        const FWIterator& end,
+        SerializedBatch& batch)
+{
+    const struct ddsi_sertype *type = this->topic_->get_ser_type();
+    for (FWIterator b = begin; b != end; ++b)
+        batch.append(type, &static_cast<const T&>(*b));
+}
+
+template <typename T>
+template <typename SamplesFWIterator, typename HandlesFWIterator>
+void
+dds::pub::detail::DataWriter<T>::collect_samples(
+        const SamplesFWIterator& data_begin,
+        const SamplesFWIterator& data_end,
+        const HandlesFWIterator& handle_begin,
+        const HandlesFWIterator& handle_end,
+        SerializedBatch& batch)
+{
+    /* Handles are not passed on (see AnyDataWriterDelegate::write), but they
+     * still limit the number of samples written. */
+    const struct ddsi_sertype *type = this->topic_->get_ser_type();
     SamplesFWIterator data = data_begin;
     HandlesFWIterator handle = handle_begin;
+    for (; data != data_end && handle != handle_end; ++data, ++handle)
+        batch.append(type, &static_cast<const T&>(*data));
+}
 
-    while(data != data_end && handle != handle_end)
-    {
-        this->writedispose(*data, *handle, timestamp);
-        ++data;
-        ++handle;
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write_samples(
+        SerializedBatch& batch,
+        const dds::core::Time& timestamp,
+        bool dispose)
+{
+    if (batch.empty())
+        return;
+
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    if (dispose) {
+        AnyDataWriterDelegate::writedispose_batch(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  batch,
+                                  timestamp);
+    } else {
+        AnyDataWriterDelegate::write_batch(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  batch,
+                                  timestamp);
     }
 }
 
@@ -223,6 +223,10 @@ public:
         ///     }
         /// }
         /// @endcode
+        /// @note Finding the next instance involves looking at every sample in the reader,
+        /// so iterating over a large number of instances like this is slow. Reading all
+        /// samples at once is faster when they are all going to be processed.
+        ///
         /// See also @link dds::sub::DataReader::select() DataReader select() @endlink operation.
         ///
         /// @param handle the 'previous' InstanceHandle associated with new the read/take
@@ -89,6 +89,27 @@ public:
      */
     SampleRef(const SampleRef& other);
 
+    /**
+     * Moves a sample instance, without taking an additional reference to its data.
+     *
+     * @param other the sample instance to move
+     */
+    SampleRef(SampleRef&& other) noexcept;
+
+    /**
+     * Copies a sample instance.
+     *
+     * @param other the sample instance to copy
+     */
+    SampleRef& operator=(const SampleRef& other) = default;
+
+    /**
+     * Moves a sample instance, without taking an additional reference to its data.
+     *
+     * @param other the sample instance to move
+     */
+    SampleRef& operator=(SampleRef&& other) = default;
+
     /**
      * Gets the data.
      *
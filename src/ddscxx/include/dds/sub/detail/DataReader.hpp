@@ -25,6 +25,7 @@
 #include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
 
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
 
 #include <dds/dds.h>
@@ -91,6 +92,9 @@ public:
 
     virtual const dds::sub::Subscriber& subscriber() const;
 
+    virtual std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression>
+    compile_query(const std::string& expression, const std::vector<std::string>& params) const;
+
     void close();
 
     dds::sub::DataReaderListener<T>* listener();
@@ -113,6 +117,8 @@ public:
 
     void on_data_available(dds_entity_t);
 
+    void notify_data_available();
+
     void on_subscription_matched(dds_entity_t,
           org::eclipse::cyclonedds::core::SubscriptionMatchedStatusDelegate &);
 
@@ -219,9 +225,33 @@ private:
     template<typename SamplesBIIterator>
     uint32_t take(SamplesBIIterator samples, const Selector& selector);
 
+    void select_query(const Selector& selector, bool take,
+                      dds::sub::detail::SamplesHolder& samples, uint32_t max_samples);
+
  private:
+    template <typename U = T, DDSCXX_STD_IMPL::enable_if_t<org::eclipse::cyclonedds::core::cdr::has_filter_members<U>::value> * = nullptr>
+    static std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression>
+    compile_filter(const std::string& expression, const std::vector<std::string>& params)
+    {
+        return std::make_shared<org::eclipse::cyclonedds::topic::TypedFilterExpression<U> >(expression, params);
+    }
+
+    template <typename U = T, DDSCXX_STD_IMPL::enable_if_t<!org::eclipse::cyclonedds::core::cdr::has_filter_members<U>::value> * = nullptr>
+    static std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression>
+    compile_filter(const std::string&, const std::vector<std::string>&)
+    {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR,
+            "Query expressions are not supported for this type.");
+        return nullptr;
+    }
+
     T typed_sample_;
 
+    /* Typed reference to this reader, so that listener callbacks can create the
+     * wrapper without a dynamic cast. It is weak, as otherwise the reader would
+     * keep itself alive. */
+    weak_ref_type typed_weak_ref_;
+
 };
 
 
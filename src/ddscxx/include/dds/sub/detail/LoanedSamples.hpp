@@ -76,8 +76,8 @@ public:
         return this->samples_.data();
     }
 
-    void append_sample(dds::sub::SampleRef<T, dds::sub::detail::SampleRef>& s) {
-        samples_.push_back(s);
+    void append_sample(dds::sub::SampleRef<T, dds::sub::detail::SampleRef>&& s) {
+        samples_.push_back(std::move(s));
     }
 
 
@@ -143,8 +143,8 @@ public:
         return this->samples_.data();
     }
 
-    void append_sample(dds::sub::Sample<org::eclipse::cyclonedds::topic::CDRBlob, dds::sub::detail::Sample>& s) {
-        samples_.push_back(s);
+    void append_sample(dds::sub::Sample<org::eclipse::cyclonedds::topic::CDRBlob, dds::sub::detail::Sample>&& s) {
+        samples_.push_back(std::move(s));
     }
 
 
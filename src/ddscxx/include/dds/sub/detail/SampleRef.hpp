@@ -57,6 +57,11 @@ public:
         copy(other);
     }
 
+    SampleRef(SampleRef&& other) noexcept : data_(other.data_), info_(std::move(other.info_))
+    {
+        other.data_ = nullptr;
+    }
+
     virtual ~SampleRef()
     {
         if (data_ != nullptr) {
@@ -68,7 +73,25 @@ public:
     {
       if (this != &other)
       {
+          ddscxx_serdata<T>* old = data_;
           copy(other);
+          if (old != nullptr) {
+              ddsi_serdata_unref(old);
+          }
+      }
+      return *this;
+    }
+
+    SampleRef& operator=(SampleRef&& other) noexcept
+    {
+      if (this != &other)
+      {
+          if (data_ != nullptr) {
+              ddsi_serdata_unref(data_);
+          }
+          data_ = other.data_;
+          other.data_ = nullptr;
+          info_ = std::move(other.info_);
       }
       return *this;
     }
@@ -80,7 +103,38 @@ public:
       {
           throw dds::core::Error("Data is Null");
       }
-      return *data_->getT();
+      const T* t = data_->getT();
+      if (t == nullptr)
+      {
+          throw dds::core::InvalidDataError("Data could not be deserialized");
+      }
+      return *t;
+    }
+
+    /**
+     * Returns a read-only view on the data, which accesses its members directly in
+     * the received CDR representation instead of deserializing the whole sample.
+     * Only available for types for which idlcxx generates a view. The view refers
+     * to the data of this sample, and must not outlive it.
+     */
+    org::eclipse::cyclonedds::core::cdr::view<T> data_view() const
+    {
+      if (data_ == nullptr)
+      {
+          throw dds::core::Error("Data is Null");
+      }
+      org::eclipse::cyclonedds::core::cdr::view_buffer buf;
+      if (data_->kind != SDK_DATA
+       || !view_buffer_from_buffer<T>(data_->data(), data_->size(), buf))
+      {
+          throw dds::core::InvalidDataError("Data can not be viewed");
+      }
+      org::eclipse::cyclonedds::core::cdr::view<T> v(buf, 0);
+      if (!org::eclipse::cyclonedds::core::cdr::view_valid(v))
+      {
+          throw dds::core::InvalidDataError("Data could not be located");
+      }
+      return v;
     }
 
     const dds::sub::SampleInfo& info() const
@@ -19,6 +19,10 @@
 #include "org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp"
 #include "org/eclipse/cyclonedds/topic/datatopic.hpp"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace dds
 {
 namespace sub
@@ -26,6 +30,69 @@ namespace sub
 namespace detail
 {
 
+/* Samples that were taken or read, but could not be deserialized when their
+ * deserialization was deferred, are delivered as invalid samples without data,
+ * as they are no longer available from the reader. */
+inline dds::sub::SampleInfo invalid_sample_info(dds::sub::SampleInfo info)
+{
+    info.delegate().valid(false);
+    return info;
+}
+
+/* Samples collected for deserialization after collecting has finished, so that
+ * deserialization can be done in parallel. Keeps a reference to the serdata of
+ * each sample until it has been emitted. */
+template <typename T>
+class DeferredSamples
+{
+public:
+    DeferredSamples() = default;
+    DeferredSamples(const DeferredSamples&) = delete;
+    DeferredSamples& operator=(const DeferredSamples&) = delete;
+
+    ~DeferredSamples()
+    {
+        release();
+    }
+
+    void append(ddscxx_serdata<T> *sd, const dds_sample_info_t *si)
+    {
+        pending_.emplace_back(sd, SamplesHolder::sample_info_from_c(si));
+        ddsi_serdata_ref(sd);
+    }
+
+    /* Deserializes the samples, in parallel when there are enough of them, and
+     * calls emit for each of them in the order in which they were collected.
+     * Samples that could not be deserialized are emitted as invalid samples. */
+    template <typename EMIT>
+    void complete(const org::eclipse::cyclonedds::sub::ParallelDeserialization& parallel, EMIT emit)
+    {
+        if (pending_.size() >= parallel.min_samples && pending_.size() > 1) {
+            parallel.executor(pending_.size(), [this](size_t i) {
+                (void)pending_[i].first->getT();
+            });
+        }
+        for (auto& p: pending_) {
+            const T* t = p.first->getT();
+            if (t != nullptr)
+                emit(*t, p.second);
+            else
+                emit(T(), invalid_sample_info(p.second));
+        }
+        release();
+    }
+
+private:
+    void release()
+    {
+        for (auto& p: pending_)
+            ddsi_serdata_unref(p.first);
+        pending_.clear();
+    }
+
+    std::vector<std::pair<ddscxx_serdata<T>*, dds::sub::SampleInfo> > pending_;
+};
+
 template <typename T>
 class LoanedSamplesHolder : public SamplesHolder
 {
@@ -44,18 +111,42 @@ public:
         return *this;
     }
 
+    void reserve(uint32_t max_samples)
+    {
+        samples_.delegate()->reserve(max_samples);
+    }
+
     void append_sample(void *sample, const dds_sample_info_t *si)
     {
         ddscxx_serdata<T> *sd = static_cast<ddscxx_serdata<T>*>(sample);
+        dds::sub::SampleRef<T> latest_sample;
         latest_sample.delegate().data_ptr(sd);
         latest_sample.delegate().info(sample_info_from_c(si));
-        samples_.delegate()->append_sample(latest_sample);
+        samples_.delegate()->append_sample(std::move(latest_sample));
+    }
+
+    void deserialize_with(const std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization>& parallel)
+    {
+        parallel_ = parallel;
+    }
+
+    /* Samples in a loan are deserialized on first access, in parallel mode they
+     * are all deserialized up front so that accessing them is cheap. */
+    void complete()
+    {
+        uint32_t length = samples_.length();
+        if (!parallel_ || length < parallel_->min_samples || length < 2)
+            return;
+        dds::sub::SampleRef<T> *buffer = samples_.delegate()->get_buffer();
+        parallel_->executor(length, [buffer](size_t i) {
+            (void)buffer[i].delegate().data_ptr()->getT();
+        });
     }
 
 private:
     dds::sub::LoanedSamples<T>& samples_;
-    dds::sub::SampleRef<T> latest_sample;
     uint32_t index_;
+    std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization> parallel_;
 };
 
 class CDRSamplesHolder : public SamplesHolder
@@ -75,6 +166,11 @@ public:
         return *this;
     }
 
+    void reserve(uint32_t max_samples)
+    {
+        samples_.delegate()->reserve(max_samples);
+    }
+
     void append_sample(void *sample, const dds_sample_info_t *si)
     {
         ddscxx_serdata<org::eclipse::cyclonedds::topic::CDRBlob> *sd;
@@ -94,7 +190,7 @@ public:
             }
             dds::sub::Sample<org::eclipse::cyclonedds::topic::CDRBlob, dds::sub::detail::Sample> blob_sample(
                 emptyBlob, sample_info_from_c(si));
-            samples_.delegate()->append_sample(blob_sample);
+            samples_.delegate()->append_sample(std::move(blob_sample));
             dds::sub::Sample<org::eclipse::cyclonedds::topic::CDRBlob, dds::sub::detail::Sample> *buffer;
             buffer = samples_.delegate()->get_buffer();
             org::eclipse::cyclonedds::topic::CDRBlob &sample_data = buffer[samples_.length() - 1].delegate().data();
@@ -143,13 +239,38 @@ public:
     void append_sample(void *sample, const dds_sample_info_t *si)
     {
         ddscxx_serdata<T>* sd = static_cast<ddscxx_serdata<T>*>(sample);
-        (iterator++)->delegate() = dds::sub::detail::Sample<T>(*sd->getT(), sample_info_from_c(si));
+        if (parallel_) {
+            deferred_.append(sd, si);
+            return;
+        }
+        const T* t = sd->getT();
+        if (t != nullptr)
+            (iterator++)->delegate() = dds::sub::detail::Sample<T>(*t, sample_info_from_c(si));
+        else
+            (iterator++)->delegate() = dds::sub::detail::Sample<T>(T(), invalid_sample_info(sample_info_from_c(si)));
         ++size;
     }
 
+    void deserialize_with(const std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization>& parallel)
+    {
+        parallel_ = parallel;
+    }
+
+    void complete()
+    {
+        if (parallel_) {
+            deferred_.complete(*parallel_, [this](const T& t, const dds::sub::SampleInfo& info) {
+                (iterator++)->delegate() = dds::sub::detail::Sample<T>(t, info);
+                ++size;
+            });
+        }
+    }
+
 private:
     SamplesFWIterator& iterator;
     uint32_t size;
+    std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization> parallel_;
+    DeferredSamples<T> deferred_;
 
 };
 
@@ -174,17 +295,46 @@ public:
     void append_sample(void *sample, const dds_sample_info_t *si)
     {
         ddscxx_serdata<T>* sd = static_cast<ddscxx_serdata<T>*>(sample);
-        last_sample.delegate().data() = *sd->getT();
-        last_sample.delegate().info(sample_info_from_c(si));
+        if (parallel_) {
+            deferred_.append(sd, si);
+            return;
+        }
+        const T* t = sd->getT();
+        if (t != nullptr)
+            emit(*t, sample_info_from_c(si));
+        else
+            emit(T(), invalid_sample_info(sample_info_from_c(si)));
+    }
+
+    void deserialize_with(const std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization>& parallel)
+    {
+        parallel_ = parallel;
+    }
+
+    void complete()
+    {
+        if (parallel_) {
+            deferred_.complete(*parallel_, [this](const T& t, const dds::sub::SampleInfo& info) {
+                emit(t, info);
+            });
+        }
+    }
+
+private:
+    void emit(const T& t, const dds::sub::SampleInfo& info)
+    {
+        last_sample.delegate().data() = t;
+        last_sample.delegate().info(info);
         iterator = std::move(last_sample);
         ++iterator;
         ++size;
     }
 
-private:
     SamplesBIIterator& iterator;
     dds::sub::Sample<T> last_sample;
     uint32_t size;
+    std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization> parallel_;
+    DeferredSamples<T> deferred_;
 
 };
 
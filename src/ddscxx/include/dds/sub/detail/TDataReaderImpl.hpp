@@ -527,6 +527,7 @@ dds::sub::detail::DataReader<T>::init(ObjectDelegate::weak_ref_type weak_ref)
 {
     /* Set weak_ref before passing ourselves to other isocpp objects. */
     this->set_weak_ref(weak_ref);
+    this->typed_weak_ref_ = ::std::dynamic_pointer_cast<DataReader<T> >(weak_ref.lock());
     /* Add weak_ref to the map of entities */
     this->add_to_entity_map(weak_ref);
     /* Add the datareader to the datareader set of the subscriber */
@@ -701,6 +702,13 @@ dds::sub::detail::DataReader<T>::subscriber() const
     return sub_;
 }
 
+template <typename T>
+std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression>
+dds::sub::detail::DataReader<T>::compile_query(const std::string& expression, const std::vector<std::string>& params) const
+{
+    return compile_filter(expression, params);
+}
+
 template <typename T>
 void
 dds::sub::detail::DataReader<T>::close()
@@ -749,8 +757,7 @@ template <typename T>
 dds::sub::DataReader<T, dds::sub::detail::DataReader>
 dds::sub::detail::DataReader<T>::wrapper()
 {
-    typename DataReader::ref_type ref =
-            ::std::dynamic_pointer_cast<DataReader<T> >(this->get_strong_ref());
+    typename DataReader::ref_type ref = this->typed_weak_ref_.lock();
     dds::sub::DataReader<T, dds::sub::detail::DataReader> reader(ref);
 
     return reader;
@@ -838,7 +845,6 @@ typename dds::sub::detail::DataReader<T>::Selector&
 dds::sub::detail::DataReader<T>::Selector::filter_content(
     const dds::sub::Query& query)
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Read with queries not currently supported");
     this->query_ = query;
     switch (this->mode) {
     case SELECT_MODE_READ:
@@ -974,19 +980,9 @@ dds::sub::detail::DataReader<T>::read(const Selector& selector)
                                                         selector.max_samples_);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, false, holder, selector.max_samples_);
         break;
     }
 
@@ -1022,19 +1018,9 @@ dds::sub::detail::DataReader<T>::take(const Selector& selector)
                                                         selector.max_samples_);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, true, holder, selector.max_samples_);
         break;
     }
 
@@ -1074,19 +1060,9 @@ dds::sub::detail::DataReader<T>::read(SamplesFWIterator samples,
                                                         max_samples);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, false, holder, max_samples);
         break;
     }
 
@@ -1124,19 +1100,9 @@ dds::sub::detail::DataReader<T>::take(SamplesFWIterator samples,
                                                         max_samples);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, true, holder, max_samples);
         break;
     }
 
@@ -1174,19 +1140,9 @@ dds::sub::detail::DataReader<T>::read(SamplesBIIterator samples, const Selector&
                                                         selector.max_samples_);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, false, holder, selector.max_samples_);
         break;
     }
 
@@ -1222,25 +1178,69 @@ dds::sub::detail::DataReader<T>::take(SamplesBIIterator samples, const Selector&
                                                         selector.max_samples_);
         break;
     case SELECT_MODE_READ_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
-        break;
     case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
-        /* When SQL queries and QueryContitions are supported, then
-         * create a QueryContitions from the Query and Reader status_filter_.
-         * Use the resulting condition entity to read. */
+        this->select_query(selector, true, holder, selector.max_samples_);
         break;
     }
 
     return holder.get_length();
 }
 
+template <typename T>
+void
+dds::sub::detail::DataReader<T>::select_query(const Selector& selector, bool take,
+              dds::sub::detail::SamplesHolder& samples, uint32_t max_samples)
+{
+    std::shared_ptr<const org::eclipse::cyclonedds::topic::FilterExpression> filter;
+    dds_entity_t condition = selector.query_.delegate()->query_condition(filter);
+    dds::core::InstanceHandle handle = selector.handle;
+
+    if (selector.mode == SELECT_MODE_READ_WITH_CONDITION) {
+        /* When the expression the condition evaluates fixes the values of all key
+         * members, only the samples of that instance can match, so only that
+         * instance needs to be looked at. */
+        bool keyed = false;
+        if (filter && filter->fixes_key()) {
+            T key;
+            if ((keyed = filter->key(&key))) {
+                handle = this->lookup_instance(key);
+                if (handle.is_nil()) {
+                    return;
+                }
+            }
+        }
+        if (!keyed) {
+            if (take) {
+                this->AnyDataReaderDelegate::take(condition, selector.state_filter_, samples, max_samples);
+            } else {
+                this->AnyDataReaderDelegate::read(condition, selector.state_filter_, samples, max_samples);
+            }
+            return;
+        }
+    }
+
+    switch(selector.mode) {
+    case SELECT_MODE_READ_WITH_CONDITION:
+    case SELECT_MODE_READ_INSTANCE_WITH_CONDITION:
+        if (take) {
+            this->AnyDataReaderDelegate::take_instance(condition, handle, selector.state_filter_, samples, max_samples);
+        } else {
+            this->AnyDataReaderDelegate::read_instance(condition, handle, selector.state_filter_, samples, max_samples);
+        }
+        break;
+    case SELECT_MODE_READ_NEXT_INSTANCE_WITH_CONDITION:
+        if (take) {
+            this->AnyDataReaderDelegate::take_next_instance(condition, handle, selector.state_filter_, samples, max_samples);
+        } else {
+            this->AnyDataReaderDelegate::read_next_instance(condition, handle, selector.state_filter_, samples, max_samples);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 
 namespace dds
 {
@@ -1370,14 +1370,23 @@ void dds::sub::detail::DataReader<T>::on_liveliness_changed(dds_entity_t,
 template <typename T>
 void dds::sub::detail::DataReader<T>::on_data_available(dds_entity_t)
 {
-    auto sr = this->get_strong_ref();
-    if (sr) {
-        dds::sub::DataReader<T, dds::sub::detail::DataReader> dr = wrapper();
+    if (!this->offload_data_available())
+        this->notify_data_available();
+}
 
-        dds::sub::DataReaderListener<T>* l =
-            reinterpret_cast<dds::sub::DataReaderListener<T> *>(this->listener_get());
-        if (l)
-          l->on_data_available(dr);
+template <typename T>
+void dds::sub::detail::DataReader<T>::notify_data_available()
+{
+    /* Invoked for every sample that arrives, so the wrapper is only created
+     * when there is a listener, and from the typed reference to this reader. */
+    dds::sub::DataReaderListener<T>* l =
+        reinterpret_cast<dds::sub::DataReaderListener<T> *>(this->listener_get());
+    if (l) {
+        typename DataReader::ref_type ref = this->typed_weak_ref_.lock();
+        if (ref) {
+            dds::sub::DataReader<T, dds::sub::detail::DataReader> dr(ref);
+            l->on_data_available(dr);
+        }
     }
 }
 
@@ -35,6 +35,9 @@ SampleRef<T, DELEGATE>::SampleRef(const T& data, const SampleInfo& info) : dds::
 template <typename T, template <typename Q> class DELEGATE>
 SampleRef<T, DELEGATE>::SampleRef(const SampleRef& other) : dds::core::Value< DELEGATE<T> >(other.delegate()) { }
 
+template <typename T, template <typename Q> class DELEGATE>
+SampleRef<T, DELEGATE>::SampleRef(SampleRef&& other) noexcept : dds::core::Value< DELEGATE<T> >(std::move(other)) { }
+
 template <typename T, template <typename Q> class DELEGATE>
 const typename SampleRef<T, DELEGATE>::DataType& SampleRef<T, DELEGATE>::data() const
 {
@@ -18,6 +18,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include <dds/topic/Topic.hpp>
 #include <dds/topic/Filter.hpp>
 #include <org/eclipse/cyclonedds/topic/TopicDescriptionDelegate.hpp>
+#include <org/eclipse/cyclonedds/topic/FilterExpression.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
 
@@ -253,9 +255,17 @@ public:
           myFilter(filter),
           myFunctor(nullptr)
     {
+        if (!filter.expression().empty())
+            myExpression = compile_expression();
         topic.delegate()->incrNrDependents();
         this->myParticipant.delegate()->add_cfTopic(*this);
         this->ser_type_ = topic->get_ser_type();
+        if (myExpression) {
+            /* ddsc only passes the filter a deserialized sample, so the expression cannot
+               be evaluated on the CDR of received samples. */
+            std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> expression = myExpression;
+            filter_function([expression](const T& sample) { return expression->matches(&sample); });
+        }
     }
 
     virtual ~ContentFilteredTopic()
@@ -367,9 +377,10 @@ public:
     template <typename FWIterator>
     void filter_parameters(const FWIterator& begin, const FWIterator& end)
     {
-        ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Changing of Filter parameters is currently not supported.");
+        org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+        if (myExpression)
+            myExpression->parameters(std::vector<std::string>(begin, end));
         myFilter.parameters(begin, end);
-        //@todo validate_filter();
     }
 
     const dds::topic::Topic<T>& topic() const
@@ -427,6 +438,23 @@ public:
     }
 
 private:
+    /* Compiles the filter expression once, changed parameters are passed to the compiled
+       expression without recompiling it. */
+    template <typename U = T, DDSCXX_STD_IMPL::enable_if_t<org::eclipse::cyclonedds::core::cdr::has_filter_members<U>::value> * = nullptr>
+    std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> compile_expression() const
+    {
+        return std::make_shared<org::eclipse::cyclonedds::topic::TypedFilterExpression<U> >(
+            myFilter.expression(), std::vector<std::string>(myFilter.begin(), myFilter.end()));
+    }
+
+    template <typename U = T, DDSCXX_STD_IMPL::enable_if_t<!org::eclipse::cyclonedds::core::cdr::has_filter_members<U>::value> * = nullptr>
+    std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> compile_expression() const
+    {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR,
+            "Filter expressions are not supported for this type, use a filter function instead.");
+        return nullptr;
+    }
+
     template <typename Functor>
     void filter_function_internal(Functor && func, dds_topic_filter * flt)
     {
@@ -451,6 +479,7 @@ private:
     dds::topic::Topic<T> myTopic;
     dds::topic::Filter myFilter;
     FunctorHolderBase *myFunctor;
+    std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> myExpression;
 };
 
 }
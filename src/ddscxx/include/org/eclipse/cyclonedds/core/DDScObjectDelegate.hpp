@@ -20,6 +20,7 @@
 #include "org/eclipse/cyclonedds/core/Mutex.hpp"
 #include "org/eclipse/cyclonedds/core/ObjectDelegate.hpp"
 
+#include <atomic>
 #include <unordered_map>
 
 #include "dds/dds.h"
@@ -53,12 +54,10 @@ public:
     static ObjectDelegate::ref_type extract_strong_ref(dds_entity_t e);
 
 protected:
-    dds_entity_t ddsc_entity;
+    /* Atomic, so that it can be read without taking the object lock. */
+    std::atomic<dds_entity_t> ddsc_entity;
 
-private:
     void delete_from_entity_map();
-    static org::eclipse::cyclonedds::core::DDScObjectDelegate::entity_map_type entity_map;
-    static Mutex entity_map_mutex;
 };
 
 DDSCXX_WARNING_MSVC_ON(4251)
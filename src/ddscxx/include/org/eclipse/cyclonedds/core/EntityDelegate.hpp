@@ -22,6 +22,8 @@
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
 #include <org/eclipse/cyclonedds/core/status/StatusDelegate.hpp>
 
+#include <atomic>
+
 namespace org
 {
 namespace eclipse
@@ -129,7 +131,8 @@ protected:
     static volatile unsigned int entityID_;
     bool enabled_;
     dds::core::status::StatusMask listener_mask;
-    long callback_count;
+    /* Number of callbacks in progress, or'ed with a flag once callbacks are prevented. */
+    std::atomic<long> callback_count;
     dds_listener_t *listener_callbacks;
 
 private:
@@ -19,6 +19,8 @@
 #include "dds/core/refmacros.hpp"
 #include "org/eclipse/cyclonedds/core/Mutex.hpp"
 
+#include <atomic>
+
 namespace org
 {
 namespace eclipse
@@ -54,7 +56,7 @@ protected:
     void set_weak_ref (const ObjectDelegate::weak_ref_type &weak_ref);
 
     Mutex mutex;
-    bool closed;
+    std::atomic<bool> closed;
     ObjectDelegate::weak_ref_type myself;
 };
 
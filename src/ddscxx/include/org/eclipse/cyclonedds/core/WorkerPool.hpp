@@ -0,0 +1,121 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_CORE_WORKER_POOL_HPP_
+#define CYCLONEDDS_CORE_WORKER_POOL_HPP_
+
+#include <dds/core/macros.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+/**
+ * @brief
+ * Executor for indexed tasks.
+ *
+ * Calls task(i) for every i in [0, count), possibly concurrently, and returns once
+ * all calls have finished. Exceptions thrown by the task are passed on to the caller.
+ */
+typedef std::function<void(size_t count, const std::function<void(size_t)>& task)> ParallelExecutor;
+
+/**
+ * @brief
+ * Executor for asynchronous tasks.
+ *
+ * Calls task once, on some thread, some time after it was handed over, and returns
+ * without waiting for it.
+ */
+typedef std::function<void(std::function<void()> task)> TaskExecutor;
+
+DDSCXX_WARNING_MSVC_OFF(4251)
+
+/**
+ * @brief
+ * Fixed size pool of worker threads, executing indexed tasks and asynchronous tasks.
+ *
+ * The thread calling run() takes part in executing the tasks, so a pool with n
+ * threads executes up to n+1 tasks at the same time. Concurrent calls to run()
+ * are executed one after the other, and wait for the asynchronous tasks that are
+ * running. Asynchronous tasks that have not started when the pool is destroyed
+ * are dropped.
+ */
+class OMG_DDS_API WorkerPool
+{
+public:
+    explicit WorkerPool(size_t threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief
+     * Calls task(i) for every i in [0, count) on the threads of the pool and the
+     * calling thread, and returns once all calls have finished.
+     *
+     * The first exception thrown by the task is rethrown. Calling run() from a task
+     * executing on the same pool, indexed or asynchronous, would wait for that task
+     * itself and throws dds::core::PreconditionNotMetError instead.
+     */
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief
+     * Executes task on one of the threads of the pool, without waiting for it.
+     *
+     * Exceptions thrown by the task are ignored. A pool without threads executes
+     * the task before returning.
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief
+     * Creates an executor running its tasks on a new pool with the given number of threads.
+     *
+     * The pool is kept alive by the executor and its copies.
+     */
+    static ParallelExecutor executor(size_t threads);
+
+    /**
+     * @brief
+     * Creates an executor posting its tasks to a new pool with the given number of threads.
+     *
+     * The pool is kept alive by the executor and its copies, and may be destroyed
+     * by one of its own tasks.
+     */
+    static TaskExecutor task_executor(size_t threads);
+
+private:
+    class Impl;
+    std::shared_ptr<Impl> impl;
+};
+
+DDSCXX_WARNING_MSVC_ON(4251)
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_CORE_WORKER_POOL_HPP_ */
@@ -14,6 +14,7 @@
 #include "dds/ddsrt/endian.h"
 #include <org/eclipse/cyclonedds/core/type_helpers.hpp>
 #include <org/eclipse/cyclonedds/core/cdr/entity_properties.hpp>
+#include <algorithm>
 #include <stdint.h>
 #include <string>
 #include <stdexcept>
@@ -122,6 +123,51 @@ inline void byte_swap(T* toswap) noexcept {
     std::swap(*u1, *u2);
 }
 
+/**
+ * @brief
+ * Byte swapping function, is only enabled for arithmetic (base) types of size 16.
+ *
+ * This is long double on some platforms, its bytes are reversed one by one.
+ *
+ * @param[in, out] toswap Pointer to the entity whose bytes will be swapped.
+ */
+template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && sizeof(T) == 16, bool> = true >
+inline void byte_swap(T* toswap) noexcept {
+    auto u = reinterpret_cast<unsigned char*>(toswap);
+
+    std::reverse(u, u + sizeof(T));
+}
+
+/**
+ * @brief
+ * Minimum number of entities for which byte_swap_n is used instead of swapping
+ * the entities one by one.
+ */
+constexpr size_t byte_swap_n_threshold = 16;
+
+/**
+ * @brief
+ * Whether N entities of type T are swapped by byte_swap_n, which only handles
+ * entities of size 2, 4 or 8.
+ */
+template<typename T>
+constexpr bool use_byte_swap_n(size_t N) {
+  return (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) && N >= byte_swap_n_threshold;
+}
+
+/**
+ * @brief
+ * Byte swapping function for arrays of entities of size 2, 4 or 8.
+ *
+ * Swaps the bytes of each entity in place, using vector instructions where the
+ * processor supports them, which is determined once at runtime.
+ *
+ * @param[in, out] toswap Pointer to the first entity whose bytes will be swapped.
+ * @param[in] size The size of each entity.
+ * @param[in] N The number of entities to swap.
+ */
+OMG_DDS_API void byte_swap_n(void* toswap, size_t size, size_t N) noexcept;
+
 /**
  * @brief
  * Endianness types.
@@ -389,6 +435,20 @@ public:
      */
     bool is_key() const;
 
+    /**
+     * @brief
+     * Checks whether an entity can be copied directly between memory and the stream.
+     *
+     * This is the case if its memory layout is identical to its CDR representation, the
+     * stream is not streaming keys, no bytes need to be swapped and the cursor is aligned
+     * to the alignment of the entity, so that all its members end up at the same offsets.
+     *
+     * @param[in] al The alignment of the entity, 0 if its memory layout is not identical to its CDR representation.
+     *
+     * @return Whether the entity can be copied directly.
+     */
+    bool direct_copy_possible(size_t al) const;
+
     /**
      * @brief
      * Function which sets the current streaming mode.
@@ -618,8 +678,12 @@ bool read(S &str, T& toread, size_t N = 1)
   }
 
   if (sizeof(T) > 1 && str.swap_endianness()) {
-    for (size_t i = 0; i < N; i++, to++)
-      byte_swap(to);
+    if (use_byte_swap_n<T>(N)) {
+      byte_swap_n(to, sizeof(T), N);
+    } else {
+      for (size_t i = 0; i < N; i++, to++)
+        byte_swap(to);
+    }
   }
 
   str.incr_position(sizeof(T)*N);
@@ -694,8 +758,12 @@ bool write(S& str, const T& towrite, size_t N = 1)
 
   if (sizeof(T) > 1 && str.swap_endianness()) {
     T* to = reinterpret_cast<T*>(str.get_cursor());
-    for (size_t i = 0; i < N; i++, to++)
-      byte_swap(to);
+    if (use_byte_swap_n<T>(N)) {
+      byte_swap_n(to, sizeof(T), N);
+    } else {
+      for (size_t i = 0; i < N; i++, to++)
+        byte_swap(to);
+    }
   }
 
   str.incr_position(sizeof(T)*N);
@@ -792,6 +860,114 @@ bool max(S& str, const T& max_sz, size_t N = 1)
   return move(str, max_sz, N);
 }
 
+/**
+ * @brief
+ * Direct copy layout function.
+ *
+ * Returns the alignment of T if its memory layout is identical to its CDR representation.
+ * This is the case for final structs without padding which only contain primitives, arrays of
+ * primitives and other such structs, for which this function is specialized by idlcxx.
+ *
+ * @return The alignment of T, or 0 if the memory layout of T differs from its CDR representation.
+ */
+template<typename T>
+constexpr size_t get_pod_layout_alignment() { return 0; }
+
+/**
+ * @brief
+ * Direct copy read function.
+ *
+ * Reads N instances of T from str by copying their contents directly.
+ * Should only be called if str.direct_copy_possible(get_pod_layout_alignment<T>()) is true.
+ *
+ * @param[in, out] str The stream which is read from.
+ * @param[out] toread The (first) instance to read into.
+ * @param[in] N The number of instances to read.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_trivially_copyable<T>::value
+                                               && std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool read_pod(S& str, T& toread, size_t N = 1)
+{
+  if (!str.bytes_available(sizeof(T)*N))
+    return false;
+
+  memcpy(reinterpret_cast<void*>(&toread),reinterpret_cast<const void*>(str.get_cursor()),sizeof(T)*N);
+  str.incr_position(sizeof(T)*N);
+  str.alignment(0);
+
+  return true;
+}
+
+/**
+ * @brief
+ * Direct copy write function.
+ *
+ * Writes N instances of T to str by copying their contents directly.
+ * Should only be called if str.direct_copy_possible(get_pod_layout_alignment<T>()) is true.
+ *
+ * @param[in, out] str The stream which is written to.
+ * @param[in] towrite The (first) instance to write.
+ * @param[in] N The number of instances to write.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_trivially_copyable<T>::value
+                                               && std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool write_pod(S& str, const T& towrite, size_t N = 1)
+{
+  if (!str.bytes_available(sizeof(T)*N))
+    return false;
+
+  memcpy(reinterpret_cast<void*>(str.get_cursor()),reinterpret_cast<const void*>(&towrite),sizeof(T)*N);
+  str.incr_position(sizeof(T)*N);
+  str.alignment(0);
+
+  return true;
+}
+
+/**
+ * @brief
+ * Direct copy cursor move function.
+ *
+ * Moves the cursor of str by the size of N instances of T.
+ * Should only be called if str.direct_copy_possible(get_pod_layout_alignment<T>()) is true.
+ *
+ * @param[in, out] str The stream whose cursor is moved.
+ * @param[in] N The number of instances to move.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_trivially_copyable<T>::value
+                                               && std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool move_pod(S& str, const T&, size_t N = 1)
+{
+  str.incr_position(sizeof(T)*N);
+  str.alignment(0);
+
+  return true;
+}
+
+/**
+ * @brief
+ * Direct copy max stream move function.
+ *
+ * Is the same as the direct copy cursor move function, as these types have a fixed size.
+ *
+ * @param[in, out] str The stream whose cursor is moved.
+ * @param[in] max_sz The variable to move the cursor by, no contents of this variable are used.
+ * @param[in] N The number of instances to move.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_trivially_copyable<T>::value
+                                               && std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool max_pod(S& str, const T& max_sz, size_t N = 1)
+{
+  return move_pod(str, max_sz, N);
+}
+
  /**
  * @brief
  * String type stream manipulation functions
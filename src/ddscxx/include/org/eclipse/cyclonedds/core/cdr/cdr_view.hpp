@@ -0,0 +1,495 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+#ifndef CDR_VIEW_HPP_
+#define CDR_VIEW_HPP_
+
+#include <org/eclipse/cyclonedds/core/cdr/cdr_stream.hpp>
+#include <org/eclipse/cyclonedds/core/cdr/cdr_enums.hpp>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace core {
+namespace cdr {
+
+/**
+ * @brief
+ * Read-only view template, specialized by idlcxx for each struct whose members can be
+ * accessed directly in their CDR representation.
+ *
+ * The specializations derive from cdr_view, and have an accessor for each member.
+ */
+template<typename T>
+class view;
+
+/**
+ * @brief
+ * Member descriptor for strings (bounded or unbounded) in views.
+ */
+struct cdr_string {};
+
+/**
+ * @brief
+ * Member descriptor for sequences (bounded or unbounded) of primitives in views.
+ *
+ * @tparam T The primitive type of the sequence's elements.
+ */
+template<typename T>
+struct cdr_sequence {};
+
+/**
+ * @brief
+ * Member descriptor for (multidimensional) arrays of primitives in views.
+ *
+ * @tparam T The primitive type of the array's elements.
+ * @tparam N The total number of elements in the array.
+ */
+template<typename T, size_t N>
+struct cdr_array {};
+
+/**
+ * @brief
+ * Buffer containing the CDR representation of a sample, without the encoding header.
+ *
+ * @var buffer Pointer to the start of the CDR data.
+ * @var size The number of bytes in buffer.
+ * @var swap Whether the endianness of the CDR data differs from the local endianness.
+ * @var version The encoding version of the CDR data.
+ */
+struct view_buffer {
+  const unsigned char *buffer = nullptr;
+  size_t size = 0;
+  bool swap = false;
+  encoding_version version = encoding_version::xcdr_v1;
+
+  /**
+   * @brief
+   * Aligns a position in the buffer.
+   *
+   * The alignment is capped to the maximum alignment of the encoding version.
+   *
+   * @param[in] position The position to align.
+   * @param[in] al The alignment of the entity at position.
+   *
+   * @return The aligned position, or SIZE_MAX if it is beyond the end of the buffer.
+   */
+  size_t align(size_t position, size_t al) const {
+    const size_t max_al = version == encoding_version::xcdr_v2 ? 4 : 8;
+    if (al > max_al)
+      al = max_al;
+    position += (al - position % al) % al;
+    return position > size ? SIZE_MAX : position;
+  }
+
+  /**
+   * @brief
+   * Checks whether there are at least n bytes available from position.
+   */
+  bool available(size_t position, size_t n) const {
+    return position <= size && n <= size - position;
+  }
+};
+
+/**
+ * @brief
+ * Loads a primitive value from a CDR buffer, swapping its bytes if necessary.
+ *
+ * @param[in] ptr Pointer to the value, does not need to be aligned.
+ * @param[in] swap Whether the bytes of the value need to be swapped.
+ *
+ * @return The loaded value.
+ */
+template<typename T>
+T view_load(const unsigned char *ptr, bool swap) {
+  T value;
+  memcpy(&value, ptr, sizeof(T));
+  if (swap)
+    byte_swap(&value);
+  return value;
+}
+
+template<>
+inline bool view_load<bool>(const unsigned char *ptr, bool) {
+  return *ptr != 0;
+}
+
+/**
+ * @brief
+ * String representation in a view, referencing the characters in the CDR buffer.
+ */
+class cdr_string_view {
+public:
+  typedef const char* const_iterator;
+
+  cdr_string_view() = default;
+  cdr_string_view(const char *data, size_t size): m_data(data), m_size(size) { }
+
+  const char* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  size_t length() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  const_iterator begin() const { return m_data; }
+  const_iterator end() const { return m_data + m_size; }
+  char operator[](size_t i) const { return m_data[i]; }
+
+  /**
+   * @brief
+   * Copies the referenced characters into a string.
+   */
+  std::string str() const { return std::string(m_data, m_size); }
+  operator std::string() const { return str(); }
+#if __cplusplus >= 201703L
+  operator std::string_view() const { return std::string_view(m_data, m_size); }
+#endif
+
+  bool operator==(const cdr_string_view &other) const {
+    return m_size == other.m_size && (m_size == 0 || memcmp(m_data, other.m_data, m_size) == 0);
+  }
+  bool operator!=(const cdr_string_view &other) const { return !(*this == other); }
+  bool operator==(const std::string &other) const { return *this == cdr_string_view(other.data(), other.size()); }
+  bool operator!=(const std::string &other) const { return !(*this == other); }
+  bool operator==(const char *other) const { return *this == cdr_string_view(other, strlen(other)); }
+  bool operator!=(const char *other) const { return !(*this == other); }
+
+private:
+  const char *m_data = "";
+  size_t m_size = 0;
+};
+
+/**
+ * @brief
+ * Range of primitives in a view, referencing the elements in the CDR buffer.
+ *
+ * Elements are returned by value, as they may not be aligned or in the local endianness.
+ *
+ * @tparam T The primitive type of the elements.
+ */
+template<typename T>
+class cdr_range {
+public:
+  class const_iterator {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef T reference;
+
+    const_iterator(const unsigned char *ptr, bool swap): m_ptr(ptr), m_swap(swap) { }
+    T operator*() const { return view_load<T>(m_ptr, m_swap); }
+    T operator[](difference_type n) const { return *(*this + n); }
+    const_iterator& operator++() { m_ptr += sizeof(T); return *this; }
+    const_iterator operator++(int) { const_iterator it(*this); ++*this; return it; }
+    const_iterator& operator--() { m_ptr -= sizeof(T); return *this; }
+    const_iterator operator--(int) { const_iterator it(*this); --*this; return it; }
+    const_iterator& operator+=(difference_type n) { m_ptr += n*static_cast<difference_type>(sizeof(T)); return *this; }
+    const_iterator& operator-=(difference_type n) { m_ptr -= n*static_cast<difference_type>(sizeof(T)); return *this; }
+    const_iterator operator+(difference_type n) const { const_iterator it(*this); return it += n; }
+    const_iterator operator-(difference_type n) const { const_iterator it(*this); return it -= n; }
+    difference_type operator-(const const_iterator &other) const { return (m_ptr - other.m_ptr)/static_cast<difference_type>(sizeof(T)); }
+    bool operator==(const const_iterator &other) const { return m_ptr == other.m_ptr; }
+    bool operator!=(const const_iterator &other) const { return m_ptr != other.m_ptr; }
+    bool operator<(const const_iterator &other) const { return m_ptr < other.m_ptr; }
+    bool operator>(const const_iterator &other) const { return m_ptr > other.m_ptr; }
+    bool operator<=(const const_iterator &other) const { return m_ptr <= other.m_ptr; }
+    bool operator>=(const const_iterator &other) const { return m_ptr >= other.m_ptr; }
+  private:
+    const unsigned char *m_ptr;
+    bool m_swap;
+  };
+
+  cdr_range() = default;
+  cdr_range(const unsigned char *data, size_t size, bool swap): m_data(data), m_size(size), m_swap(swap) { }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  T operator[](size_t i) const { return view_load<T>(m_data + i*sizeof(T), m_swap); }
+  const_iterator begin() const { return const_iterator(m_data, m_swap); }
+  const_iterator end() const { return const_iterator(m_data + m_size*sizeof(T), m_swap); }
+
+  /**
+   * @brief
+   * Copies the referenced elements into a vector.
+   */
+  std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+
+private:
+  const unsigned char *m_data = nullptr;
+  size_t m_size = 0;
+  bool m_swap = false;
+};
+
+/**
+ * @brief
+ * Describes how a member of a view is located in, and read from the CDR buffer.
+ *
+ * Specializations implement:
+ * - start: aligns position to the start of the member
+ * - skip: moves position from the start of the member to its end
+ * - get: returns the member located at position
+ *
+ * @tparam M The member descriptor: a primitive, an enum, cdr_string, cdr_sequence,
+ *           cdr_array or a view.
+ */
+template<typename M, typename = void>
+struct view_member;
+
+template<typename M>
+struct view_member<M, DDSCXX_STD_IMPL::enable_if_t<std::is_arithmetic<M>::value> > {
+  static size_t start(const view_buffer &buf, size_t position) { return buf.align(position, sizeof(M)); }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    if (!buf.available(position, sizeof(M)))
+      return false;
+    position += sizeof(M);
+    return true;
+  }
+  static M get(const view_buffer &buf, size_t position) { return view_load<M>(buf.buffer + position, buf.swap); }
+};
+
+template<typename M>
+struct view_member<M, DDSCXX_STD_IMPL::enable_if_t<std::is_enum<M>::value> > {
+  static constexpr size_t width() { return static_cast<size_t>(get_bit_bound<M>()); }
+  static size_t start(const view_buffer &buf, size_t position) { return buf.align(position, width()); }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    if (width() > 4 || !buf.available(position, width()))
+      return false;
+    position += width();
+    return true;
+  }
+  static M get(const view_buffer &buf, size_t position) {
+    switch (width()) {
+      case 1:
+        return enum_conversion<M>(view_load<uint8_t>(buf.buffer + position, buf.swap));
+      case 2:
+        return enum_conversion<M>(view_load<uint16_t>(buf.buffer + position, buf.swap));
+      default:
+        return enum_conversion<M>(view_load<uint32_t>(buf.buffer + position, buf.swap));
+    }
+  }
+};
+
+template<>
+struct view_member<cdr_string> {
+  static size_t start(const view_buffer &buf, size_t position) { return buf.align(position, 4); }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    if (!buf.available(position, 4))
+      return false;
+    uint32_t length = view_load<uint32_t>(buf.buffer + position, buf.swap);
+    if (length == 0 || !buf.available(position + 4, length))
+      return false;
+    position += 4 + length;
+    return true;
+  }
+  static cdr_string_view get(const view_buffer &buf, size_t position) {
+    uint32_t length = view_load<uint32_t>(buf.buffer + position, buf.swap);
+    return cdr_string_view(reinterpret_cast<const char*>(buf.buffer + position + 4), length - 1);  //remove 1 for terminating NULL
+  }
+};
+
+template<typename T>
+struct view_member<cdr_sequence<T> > {
+  static size_t start(const view_buffer &buf, size_t position) { return buf.align(position, 4); }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    if (!buf.available(position, 4))
+      return false;
+    uint32_t length = view_load<uint32_t>(buf.buffer + position, buf.swap);
+    size_t data = length ? buf.align(position + 4, sizeof(T)) : position + 4;
+    if (data == SIZE_MAX || length > (buf.size - data)/sizeof(T))
+      return false;
+    position = data + length*sizeof(T);
+    return true;
+  }
+  static cdr_range<T> get(const view_buffer &buf, size_t position) {
+    uint32_t length = view_load<uint32_t>(buf.buffer + position, buf.swap);
+    size_t data = length ? buf.align(position + 4, sizeof(T)) : position + 4;
+    return cdr_range<T>(buf.buffer + data, length, buf.swap);
+  }
+};
+
+template<typename T, size_t N>
+struct view_member<cdr_array<T, N> > {
+  static size_t start(const view_buffer &buf, size_t position) { return buf.align(position, sizeof(T)); }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    if (!buf.available(position, N*sizeof(T)))
+      return false;
+    position += N*sizeof(T);
+    return true;
+  }
+  static cdr_range<T> get(const view_buffer &buf, size_t position) { return cdr_range<T>(buf.buffer + position, N, buf.swap); }
+};
+
+/**
+ * @brief
+ * Returns whether all members of a view were located in its buffer.
+ *
+ * Goes through the base class, as the accessors of the view may hide its functions.
+ */
+template<typename T>
+bool view_valid(const view<T> &v) {
+  return static_cast<const typename view<T>::view_base&>(v).valid();
+}
+
+/**
+ * @brief
+ * Returns the offset in the buffer directly after the struct of a view.
+ */
+template<typename T>
+size_t view_end(const view<T> &v) {
+  return static_cast<const typename view<T>::view_base&>(v).end();
+}
+
+/**
+ * @brief
+ * Loads the key members of a struct from its view, specialized by idlcxx for viewable
+ * structs whose key members are all primitives, enums or strings.
+ *
+ * The specializations implement:
+ * - load: assigns the key members of sample from the view, leaving its other members untouched
+ */
+template<typename T>
+struct view_keys;
+
+/**
+ * @brief
+ * Whether idlcxx generated the loading of the key members of T from its view.
+ */
+template<typename T, typename = void>
+struct has_view_keys : std::false_type { };
+
+template<typename T>
+struct has_view_keys<T, decltype(void(&view_keys<T>::load))> : std::true_type { };
+
+template<typename M>
+struct view_member<view<M> > {
+  static size_t start(const view_buffer &, size_t position) { return position; }
+  static bool skip(const view_buffer &buf, size_t &position) {
+    view<M> v(buf, position);
+    if (!view_valid(v))
+      return false;
+    position = view_end(v);
+    return true;
+  }
+  static view<M> get(const view_buffer &buf, size_t position) { return view<M>(buf, position); }
+};
+
+/**
+ * @brief
+ * Base class of the views generated by idlcxx.
+ *
+ * Locates all members in the CDR buffer on construction, after which each member can be
+ * accessed directly without decoding the members preceding it.
+ * Only final and appendable structs consisting of primitives, enums, strings, sequences and
+ * arrays of primitives and other such structs can be viewed.
+ *
+ * @tparam E The extensibility of the viewed struct.
+ * @tparam M The member descriptors of the viewed struct, in declaration order.
+ */
+template<extensibility E, typename... M>
+class cdr_view {
+  static_assert(E != extensibility::ext_mutable, "Mutable structs cannot be viewed");
+
+public:
+  /**
+   * @brief
+   * Constructs an invalid view.
+   */
+  cdr_view() = default;
+
+  /**
+   * @brief
+   * Constructs a view on the struct starting at position in buf.
+   *
+   * @param[in] buf The buffer containing the CDR representation of the sample.
+   * @param[in] position The offset of the struct in the buffer.
+   */
+  cdr_view(const view_buffer &buf, size_t position): m_buf(buf) {
+    size_t limit = SIZE_MAX;
+    if (E == extensibility::ext_appendable && buf.version == encoding_version::xcdr_v2) {
+      position = buf.align(position, 4);
+      if (position == SIZE_MAX || !buf.available(position, 4))
+        return;
+      uint32_t dheader = view_load<uint32_t>(buf.buffer + position, buf.swap);
+      position += 4;
+      if (!buf.available(position, dheader))
+        return;
+      limit = position + dheader;
+    }
+    m_valid = locate<0, M...>(position);
+    if (m_valid && limit != SIZE_MAX) {
+      m_valid = position <= limit;
+      position = limit;
+    }
+    m_end = position;
+  }
+
+  /**
+   * @brief
+   * Returns whether all members of the struct were located in the buffer.
+   */
+  bool valid() const { return m_valid; }
+
+  /**
+   * @brief
+   * Returns the offset in the buffer directly after the struct.
+   */
+  size_t end() const { return m_end; }
+
+protected:
+  /**
+   * @brief
+   * The type returned by the accessor of the member at index I.
+   */
+  template<size_t I>
+  using member_t = decltype(view_member<typename std::tuple_element<I, std::tuple<M...> >::type>::get(view_buffer(), 0));
+
+  /**
+   * @brief
+   * Returns the member at index I, accessors of the generated views call this function.
+   */
+  template<size_t I>
+  member_t<I> get() const {
+    return view_member<typename std::tuple_element<I, std::tuple<M...> >::type>::get(m_buf, m_offsets[I]);
+  }
+
+private:
+  template<size_t I>
+  bool locate(size_t &) { return true; }
+
+  template<size_t I, typename F, typename... R>
+  bool locate(size_t &position) {
+    position = view_member<F>::start(m_buf, position);
+    if (position == SIZE_MAX)
+      return false;
+    m_offsets[I] = position;
+    return view_member<F>::skip(m_buf, position) && locate<I + 1, R...>(position);
+  }
+
+  view_buffer m_buf;
+  size_t m_offsets[sizeof...(M) ? sizeof...(M) : 1] = { 0 };
+  size_t m_end = 0;
+  bool m_valid = false;
+};
+
+}
+}
+}
+}
+} /* namespace org / eclipse / cyclonedds / core / cdr */
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <dds/core/macros.hpp>
 #include <cstdint>
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <set>
@@ -156,7 +157,65 @@ constexpr bit_bound get_bit_bound() { return bit_bound::bb_64_bits; }
 
 typedef struct entity_properties entity_properties_t;
 typedef std::vector<entity_properties_t> propvec;
-typedef std::set<uint32_t> member_id_set;
+
+/**
+ * @brief
+ * Container for the member ids of the members of a struct which were streamed.
+ *
+ * Member ids below 64, which covers all members of structs without explicitly assigned ids
+ * and fewer than 64 members, are kept in a bitmask, so that no allocations are necessary.
+ * Any other member ids are kept in a sorted vector.
+ */
+class member_id_set
+{
+public:
+  /**
+   * @brief
+   * Adds a member id to the set.
+   *
+   * @param[in] id The member id to add.
+   */
+  void insert(uint32_t id)
+  {
+    if (id < 64) {
+      m_mask |= uint64_t(1) << id;
+    } else {
+      auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+      if (it == m_ids.end() || *it != id)
+        m_ids.insert(it, id);
+    }
+  }
+
+  /**
+   * @brief
+   * Returns the number of times a member id occurs in the set.
+   *
+   * @param[in] id The member id to look for.
+   *
+   * @return 1 if the member id is in the set, 0 otherwise.
+   */
+  size_t count(uint32_t id) const
+  {
+    if (id < 64)
+      return static_cast<size_t>((m_mask >> id) & 1);
+    else
+      return std::binary_search(m_ids.begin(), m_ids.end(), id) ? 1 : 0;
+  }
+
+  /**
+   * @brief
+   * Removes all member ids from the set.
+   */
+  void clear()
+  {
+    m_mask = 0;
+    m_ids.clear();
+  }
+
+private:
+  uint64_t m_mask = 0;          /**< Bitmask of the member ids below 64.*/
+  std::vector<uint32_t> m_ids;  /**< Sorted member ids of 64 and above.*/
+};
 
 /**
  * @brief
@@ -206,6 +265,7 @@ struct OMG_DDS_API entity_properties
                        *first_sorted_key    = nullptr,  /**< Pointer to the first entity which is a key member of this entity, going by member id order.*/
                        *next_sorted_key     = nullptr,  /**< Pointer to the next entity which is a key member on the same level, going by member id order.*/
                        *prev_sorted_key     = nullptr;  /**< Pointer to the previous entity which is a key member on the same level, going by member id order.*/
+  std::vector<const entity_properties_t*> member_index;  /**< The members of this entity sorted by member id, only populated for mutable entities.*/
 
   /**
    * @brief
@@ -299,6 +359,19 @@ struct OMG_DDS_API entity_properties
     */
   const entity_properties_t* previous_entity(key_mode key) const;
 
+  /**
+    * @brief
+    * Returns the member of this entity with the supplied member id (if any).
+    *
+    * Uses the member index for mutable entities, and a walk over the members for all others.
+    *
+    * @param[in] id The member id to look for.
+    * @param[in] key The key mode to look for the member in.
+    *
+    * @return Pointer to the member, or nullptr if there is no member with that id in this key mode.
+    */
+  const entity_properties_t* find_member(uint32_t id, key_mode key) const;
+
 private:
 
   /**
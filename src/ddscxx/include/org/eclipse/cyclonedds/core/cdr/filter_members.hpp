@@ -0,0 +1,348 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+#ifndef FILTER_MEMBERS_HPP_
+#define FILTER_MEMBERS_HPP_
+
+#include <org/eclipse/cyclonedds/core/cdr/entity_properties.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace core {
+namespace cdr {
+
+/**
+ * @brief
+ * Kinds of values that can be compared in filter expressions.
+ *
+ * @var filter_kind::none No value, the member or parameter is not set.
+ * @var filter_kind::signed_int Signed integers, enums and booleans.
+ * @var filter_kind::unsigned_int Unsigned integers.
+ * @var filter_kind::floating Floating point numbers.
+ * @var filter_kind::string Strings and characters.
+ */
+enum class filter_kind {
+  none,
+  signed_int,
+  unsigned_int,
+  floating,
+  string
+};
+
+/**
+ * @brief
+ * Value of a member, literal or parameter in a filter expression.
+ *
+ * Strings are referenced, not copied, so the value is only valid as long as the sample,
+ * or the expression it was taken from.
+ */
+struct filter_value {
+  filter_kind kind = filter_kind::none;
+  int64_t i = 0;
+  uint64_t u = 0;
+  double d = 0.0;
+  const char *s = nullptr;
+  size_t len = 0;
+};
+
+/**
+ * @brief
+ * Member of a struct that is referenced by a filter expression.
+ *
+ * @var path The indices of the members to pass through from the outermost struct.
+ * @var kind The kind of the value of the member.
+ * @var key Whether the member is a key member of the outermost struct.
+ */
+struct filter_field {
+  std::vector<size_t> path;
+  filter_kind kind = filter_kind::none;
+  bool key = false;
+};
+
+/**
+ * @brief
+ * Conversion of members to and from filter values.
+ *
+ * Specialized for the members that can be referenced in filter expressions: primitives,
+ * enums and strings. Assigning a value fails if the member cannot represent it exactly.
+ */
+template<typename M, typename = void>
+struct filter_member_traits;
+
+/* converts a numeric value to a signed integer, if it is one */
+inline bool filter_integer(const filter_value &v, int64_t &i) {
+  switch (v.kind) {
+    case filter_kind::signed_int:
+      i = v.i;
+      return true;
+    case filter_kind::unsigned_int:
+      if (v.u > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        return false;
+      i = static_cast<int64_t>(v.u);
+      return true;
+    case filter_kind::floating:
+      if (!(v.d >= -9223372036854775808.0 && v.d < 9223372036854775808.0) || static_cast<double>(static_cast<int64_t>(v.d)) != v.d)
+        return false;
+      i = static_cast<int64_t>(v.d);
+      return true;
+    default:
+      return false;
+  }
+}
+
+template<typename M>
+struct filter_member_traits<M, DDSCXX_STD_IMPL::enable_if_t<std::is_integral<M>::value && std::is_signed<M>::value && !std::is_same<M, char>::value> > {
+  static filter_kind kind() { return filter_kind::signed_int; }
+  static filter_value value(const M &m) {
+    filter_value v;
+    v.kind = kind();
+    v.i = static_cast<int64_t>(m);
+    return v;
+  }
+  static bool assign(M &m, const filter_value &v) {
+    int64_t i;
+    if (!filter_integer(v, i) || i < static_cast<int64_t>(std::numeric_limits<M>::min()) || i > static_cast<int64_t>(std::numeric_limits<M>::max()))
+      return false;
+    m = static_cast<M>(i);
+    return true;
+  }
+};
+
+template<typename M>
+struct filter_member_traits<M, DDSCXX_STD_IMPL::enable_if_t<std::is_integral<M>::value && !std::is_signed<M>::value && !std::is_same<M, char>::value && !std::is_same<M, bool>::value> > {
+  static filter_kind kind() { return filter_kind::unsigned_int; }
+  static filter_value value(const M &m) {
+    filter_value v;
+    v.kind = kind();
+    v.u = static_cast<uint64_t>(m);
+    return v;
+  }
+  static bool assign(M &m, const filter_value &v) {
+    int64_t i;
+    if (v.kind == filter_kind::unsigned_int) {
+      if (v.u > static_cast<uint64_t>(std::numeric_limits<M>::max()))
+        return false;
+      m = static_cast<M>(v.u);
+      return true;
+    }
+    if (!filter_integer(v, i) || i < 0 || static_cast<uint64_t>(i) > static_cast<uint64_t>(std::numeric_limits<M>::max()))
+      return false;
+    m = static_cast<M>(i);
+    return true;
+  }
+};
+
+template<>
+struct filter_member_traits<bool> {
+  static filter_kind kind() { return filter_kind::signed_int; }
+  static filter_value value(const bool &m) {
+    filter_value v;
+    v.kind = kind();
+    v.i = m ? 1 : 0;
+    return v;
+  }
+  static bool assign(bool &m, const filter_value &v) {
+    int64_t i;
+    if (!filter_integer(v, i) || (i != 0 && i != 1))
+      return false;
+    m = i != 0;
+    return true;
+  }
+};
+
+template<typename M>
+struct filter_member_traits<M, DDSCXX_STD_IMPL::enable_if_t<std::is_enum<M>::value> > {
+  static filter_kind kind() { return filter_kind::signed_int; }
+  static filter_value value(const M &m) {
+    filter_value v;
+    v.kind = kind();
+    v.i = static_cast<int64_t>(m);
+    return v;
+  }
+  static bool assign(M &m, const filter_value &v) {
+    typename std::underlying_type<M>::type u;
+    if (!filter_member_traits<decltype(u)>::assign(u, v))
+      return false;
+    m = static_cast<M>(u);
+    return true;
+  }
+};
+
+template<typename M>
+struct filter_member_traits<M, DDSCXX_STD_IMPL::enable_if_t<std::is_floating_point<M>::value> > {
+  static filter_kind kind() { return filter_kind::floating; }
+  static filter_value value(const M &m) {
+    filter_value v;
+    v.kind = kind();
+    v.d = static_cast<double>(m);
+    return v;
+  }
+  static bool assign(M &m, const filter_value &v) {
+    double d;
+    switch (v.kind) {
+      case filter_kind::signed_int: d = static_cast<double>(v.i); break;
+      case filter_kind::unsigned_int: d = static_cast<double>(v.u); break;
+      case filter_kind::floating: d = v.d; break;
+      default: return false;
+    }
+    if (!(d >= static_cast<double>(std::numeric_limits<M>::lowest()) && d <= static_cast<double>(std::numeric_limits<M>::max()))
+     || static_cast<double>(static_cast<M>(d)) != d)
+      return false;
+    m = static_cast<M>(d);
+    return true;
+  }
+};
+
+/* characters compare as strings of length 1, as character literals are written as strings */
+template<>
+struct filter_member_traits<char> {
+  static filter_kind kind() { return filter_kind::string; }
+  static filter_value value(const char &m) {
+    filter_value v;
+    v.kind = kind();
+    v.s = &m;
+    v.len = 1;
+    return v;
+  }
+  static bool assign(char &m, const filter_value &v) {
+    if (v.kind != filter_kind::string || v.len != 1)
+      return false;
+    m = v.s[0];
+    return true;
+  }
+};
+
+template<typename M>
+struct filter_member_traits<M, DDSCXX_STD_IMPL::enable_if_t<std::is_same<decltype(std::declval<const M&>().data()), const char*>::value> > {
+  static filter_kind kind() { return filter_kind::string; }
+  static filter_value value(const M &m) {
+    filter_value v;
+    v.kind = kind();
+    v.s = m.data();
+    v.len = m.size();
+    return v;
+  }
+  static bool assign(M &m, const filter_value &v) {
+    if (v.kind != filter_kind::string)
+      return false;
+    m.assign(v.s, v.len);
+    return true;
+  }
+};
+
+/**
+ * @brief
+ * Returns the filter value of a member.
+ */
+template<typename M>
+filter_value filter_load(const M &m) {
+  return filter_member_traits<M>::value(m);
+}
+
+/**
+ * @brief
+ * Assigns a filter value to a member.
+ *
+ * @return Whether the member can represent the value exactly.
+ */
+template<typename M>
+bool filter_store(M &m, const filter_value &v) {
+  return filter_member_traits<M>::assign(m, v);
+}
+
+/**
+ * @brief
+ * Member names and accessors of a struct for filter expressions, specialized by idlcxx.
+ *
+ * The specializations implement:
+ * - resolve: looks up a member by name, appending its index to field.path
+ * - load: returns the value of the member whose indices start at path
+ * - store: assigns a value to the key member at path, fails for other members
+ * - keys: the number of key members, or 0 if not all of them can be stored
+ */
+template<typename T>
+struct filter_members;
+
+/**
+ * @brief
+ * Whether idlcxx generated the member lookup for filter expressions of T.
+ */
+template<typename T, typename = void>
+struct has_filter_members : std::false_type { };
+
+template<typename T>
+struct has_filter_members<T, decltype(void(&filter_members<T>::load))> : std::true_type { };
+
+template<typename T>
+bool filter_resolve_struct(const std::string &name, size_t pos, filter_field &field) {
+  size_t next = name.find('.', pos);
+  std::string member = name.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+  if (next != std::string::npos)
+    next++;
+  return filter_members<T>::resolve(member, name, next, field);
+}
+
+/**
+ * @brief
+ * Resolves a member which is a primitive, enum or string, this must be the last part of the name.
+ */
+template<typename M>
+bool filter_resolve_leaf(size_t index, size_t next, filter_field &field, bool key = false) {
+  if (next != std::string::npos)
+    return false;
+  field.path.push_back(index);
+  field.kind = filter_member_traits<M>::kind();
+  field.key = key;
+  return true;
+}
+
+/**
+ * @brief
+ * Resolves a member which is a struct, the rest of the name is looked up in that struct.
+ */
+template<typename M>
+bool filter_resolve_nested(size_t index, const std::string &name, size_t next, filter_field &field) {
+  if (next == std::string::npos)
+    return false;
+  field.path.push_back(index);
+  /* the keys of a nested struct are not the keys of the outermost one */
+  bool ok = filter_resolve_struct<M>(name, next, field);
+  field.key = false;
+  return ok;
+}
+
+/**
+ * @brief
+ * Resolves a (dot separated) member name of T for filter expressions.
+ *
+ * @param[in] name The name of the member, for example "position.x".
+ * @param[out] field The resolved member.
+ *
+ * @return Whether the name refers to a member that can be used in filter expressions.
+ */
+template<typename T>
+bool filter_resolve(const std::string &name, filter_field &field) {
+  field = filter_field();
+  return filter_resolve_struct<T>(name, 0, field);
+}
+
+}
+}
+}
+}
+} /* namespace org / eclipse / cyclonedds / core / cdr */
+
+#endif
@@ -97,6 +97,12 @@ public:
 
     dds::core::cond::TCondition<ConditionDelegate> wrapper();
 
+protected:
+    /* Replaces the ddsc entity of this condition by entity_handle, attaching it to
+     * the waitsets the condition is attached to. The old entity is detached from
+     * them, but not deleted. */
+    void replace_ddsc_entity(const dds_entity_t entity_handle);
+
 private:
     std::set<WaitSetDelegate *> waitSetList;
     org::eclipse::cyclonedds::core::Mutex waitSetListUpdateMutex;
@@ -15,6 +15,7 @@
 #ifndef CYCLONEDDS_CORE_COND_WAITSET_DELEGATE_HPP_
 #define CYCLONEDDS_CORE_COND_WAITSET_DELEGATE_HPP_
 
+#include <atomic>
 #include <vector>
 #include <map>
 
@@ -75,6 +76,17 @@ DDSCXX_WARNING_MSVC_OFF(4251)
 
         ConditionSeq& wait (ConditionSeq& triggered, const dds::core::Duration& timeout);
 
+        /* Waits like wait(ConditionSeq&, timeout), but stores the delegates of at most
+         * max_triggered triggered conditions in triggered instead of appending
+         * Condition wrappers, and returns the number stored. Triggered conditions
+         * that did not fit remain triggered for the next wait.
+         * The stored delegates are not kept alive by this call: the caller has to
+         * keep the conditions attached, and keep a Condition referring to each of
+         * them, for as long as it uses the stored pointers. */
+        size_t wait (org::eclipse::cyclonedds::core::cond::ConditionDelegate **triggered,
+                     size_t max_triggered,
+                     const dds::core::Duration& timeout);
+
         void dispatch (const dds::core::Duration & timeout);
 
         void attach_condition (const dds::core::cond::Condition & cond);
@@ -82,11 +94,19 @@ DDSCXX_WARNING_MSVC_OFF(4251)
         void add_condition_locked(const dds::core::cond::Condition& cond);
         void remove_condition_locked(org::eclipse::cyclonedds::core::cond::ConditionDelegate *cond,
                                      const dds_entity_t entity_handle = DDS_HANDLE_NIL);
+        void replace_condition_locked(org::eclipse::cyclonedds::core::cond::ConditionDelegate *cond,
+                                      const dds_entity_t old_handle,
+                                      const dds_entity_t new_handle);
 
         ConditionSeq & conditions (ConditionSeq & conds) const;
 
     private:
         ConditionMap conditions_;
+
+        /* Buffer for the attach values of triggered conditions, lent to one waiting
+         * thread at a time and only grown when a wait needs more room. */
+        std::vector<dds_attach_t> attach_;
+        std::atomic<bool> attach_busy_{false};
     };
 
 DDSCXX_WARNING_MSVC_ON(4251)
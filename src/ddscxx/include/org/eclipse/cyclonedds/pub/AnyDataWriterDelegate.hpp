@@ -99,6 +99,36 @@ public:
     void write_flush();
     void set_batch(bool);
 
+    /* Serialized samples that are shared between writes, see SerializedSample<T>. */
+    static struct ddsi_serdata *
+    serialize_sample(const struct ddsi_sertype *type,
+          const void *data,
+          const dds::core::Time& timestamp);
+
+    static void
+    release_serdata(struct ddsi_serdata *data);
+
+    /* Samples serialized one by one while iterating over them, to be written as a
+     * batch. The samples that were not written are released with the batch. */
+    class OMG_DDS_API SerializedBatch
+    {
+    public:
+        SerializedBatch() = default;
+        ~SerializedBatch();
+
+        SerializedBatch(const SerializedBatch&) = delete;
+        SerializedBatch& operator=(const SerializedBatch&) = delete;
+
+        void append(const struct ddsi_sertype *type, const void *data);
+
+        bool empty() const { return samples_.empty(); }
+
+    private:
+        friend class AnyDataWriterDelegate;
+        std::vector<struct ddsi_serdata *> samples_;
+        size_t written_ = 0;
+    };
+
 private:
     void
     write_cdr(dds_entity_t writer,
@@ -107,6 +137,18 @@ private:
           const dds::core::Time& timestamp,
           uint32_t statusinfo);
 
+    void
+    write_batch(dds_entity_t writer,
+          SerializedBatch& batch,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo);
+
+    void
+    write_serdata(dds_entity_t writer,
+          struct ddsi_serdata *data,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo);
+
 protected:
     AnyDataWriterDelegate(const dds::pub::qos::DataWriterQos& qos,
                           const dds::topic::TopicDescription& td);
@@ -117,6 +159,15 @@ protected:
           const dds::core::InstanceHandle& handle,
           const dds::core::Time& timestamp);
 
+    void
+    write_cdr(dds_entity_t writer,
+          struct ddsi_serdata *data,
+          const dds::core::Time& timestamp);
+
+    void
+    write_serialized(dds_entity_t writer,
+          struct ddsi_serdata *data);
+
     void
     dispose_cdr(dds_entity_t writer,
           const org::eclipse::cyclonedds::topic::CDRBlob *data,
@@ -152,6 +203,18 @@ protected:
                  const dds::core::InstanceHandle& handle,
                  const dds::core::Time& timestamp);
 
+    /* Writes the samples of batch in order. When writing one of them fails, the
+     * samples before it have been written, the exception states how many. */
+    void
+    write_batch(dds_entity_t writer,
+          SerializedBatch& batch,
+          const dds::core::Time& timestamp);
+
+    void
+    writedispose_batch(dds_entity_t writer,
+                 SerializedBatch& batch,
+                 const dds::core::Time& timestamp);
+
     dds_instance_handle_t
     register_instance(dds_entity_t writer,
                       const void *data,
@@ -0,0 +1,87 @@
+// Copyright(c) 2006 to 2021 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_SERIALIZED_SAMPLE_HPP_
+#define CYCLONEDDS_PUB_SERIALIZED_SAMPLE_HPP_
+
+#include <memory>
+
+#include <dds/core/Time.hpp>
+#include <dds/topic/Topic.hpp>
+#include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/**
+ * A sample of type T that is serialized once and can then be written any
+ * number of times, to any writer of the topic it was created for, without
+ * serializing it again.
+ *
+ * The serialized data (including the keyhash) is reference counted: copies
+ * of a SerializedSample share it, and every write only adds a reference.
+ * The source timestamp is fixed when the sample is created, so that the
+ * shared data is never modified after creation and the sample can be
+ * written from several threads at once.
+ *
+ * Writing it to a writer of a topic with a different serialization type,
+ * for instance one with another data representation, makes ddsc convert it,
+ * which costs as much as writing the original sample.
+ */
+template <typename T>
+class SerializedSample
+{
+public:
+    /**
+     * Serializes sample for topic.
+     *
+     * @param topic     the topic whose serialization type is used
+     * @param sample    the sample to serialize
+     * @param timestamp the source timestamp of all writes of this sample,
+     *                  the current time if invalid
+     * @throws dds::core::Error the sample could not be serialized
+     */
+    SerializedSample(
+        const dds::topic::Topic<T>& topic,
+        const T& sample,
+        const dds::core::Time& timestamp = dds::core::Time::invalid()) :
+            topic_(topic),
+            serdata_(AnyDataWriterDelegate::serialize_sample(topic->get_ser_type(), &sample, timestamp),
+                     &AnyDataWriterDelegate::release_serdata)
+    {
+    }
+
+    const dds::topic::Topic<T>& topic() const { return this->topic_; }
+
+    struct ddsi_serdata *serdata() const { return this->serdata_.get(); }
+
+private:
+    /* Keeps the serialization type, that the serdata refers to, alive. */
+    dds::topic::Topic<T> topic_;
+    std::shared_ptr<struct ddsi_serdata> serdata_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_SERIALIZED_SAMPLE_HPP_ */
@@ -24,14 +24,20 @@
 #include <dds/sub/Sample.hpp>
 #include <dds/sub/SampleInfo.hpp>
 #include <org/eclipse/cyclonedds/core/EntityDelegate.hpp>
+#include <org/eclipse/cyclonedds/core/Mutex.hpp>
+#include <org/eclipse/cyclonedds/core/WorkerPool.hpp>
 #include <org/eclipse/cyclonedds/topic/TopicTraits.hpp>
 #include <org/eclipse/cyclonedds/core/ObjectSet.hpp>
 #include <org/eclipse/cyclonedds/ForwardDeclarations.hpp>
 #include <dds/topic/TopicDescription.hpp>
 #include <org/eclipse/cyclonedds/topic/CDRBlob.hpp>
+#include <org/eclipse/cyclonedds/topic/FilterExpression.hpp>
 
 #include <dds/topic/BuiltinTopic.hpp>
 
+#include <atomic>
+#include <vector>
+
 
 namespace dds { namespace sub {
 template <typename DELEGATE>
@@ -47,6 +53,19 @@ namespace cyclonedds
 namespace sub
 {
 class QueryContainer;
+
+/**
+ * @brief
+ * Settings for deserializing the samples of a read or take in parallel.
+ *
+ * Samples are deserialized by the executor after they have all been collected,
+ * when at least min_samples were collected, and are returned in their original order.
+ */
+struct ParallelDeserialization
+{
+    org::eclipse::cyclonedds::core::ParallelExecutor executor;
+    uint32_t min_samples;
+};
 }
 }
 }
@@ -68,6 +87,9 @@ public:
     virtual uint32_t get_length() const = 0;
     virtual SamplesHolder& operator++(int) = 0;
     virtual void append_sample(void *sample, const dds_sample_info_t *si) = 0;
+    virtual void reserve(uint32_t) {}
+    virtual void deserialize_with(const std::shared_ptr<const org::eclipse::cyclonedds::sub::ParallelDeserialization>&) {}
+    virtual void complete() {}
     static dds::sub::SampleInfo sample_info_from_c(const dds_sample_info_t *si);
 };
 
@@ -105,6 +127,10 @@ public:
 
     /* Let DataReader<T> implement the subscriber handling to circumvent circular dependencies. */
     virtual const dds::sub::TSubscriber<org::eclipse::cyclonedds::sub::SubscriberDelegate>& subscriber() const = 0;
+
+    /* Let DataReader<T> compile query expressions, only it knows the members of the samples. */
+    virtual std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression>
+    compile_query(const std::string& expression, const std::vector<std::string>& params) const = 0;
     const dds::topic::TopicDescription& topic_description() const;
 
     void wait_for_historical_data(const dds::core::Duration& timeout);
@@ -260,17 +286,112 @@ public:
 
     void close();
 
+    /* Deserialize the samples of reads and takes collecting at least min_samples
+     * samples using executor, an empty executor deserializes them one by one again. */
+    void parallel_deserialization(
+            const org::eclipse::cyclonedds::core::ParallelExecutor& executor,
+            uint32_t min_samples);
+
+    /* Invoke the data available listener through executor, an empty executor
+     * invokes it from the ddsc listener thread again. Notifications arriving
+     * while an invocation is pending or running are coalesced into the next one,
+     * and the listener is never invoked concurrently for this reader. */
+    void listener_executor(const org::eclipse::cyclonedds::core::TaskExecutor& executor);
+
+protected:
+    /* Hands a data available notification to the listener executor, returns
+     * false when there is none and the listener is to be invoked directly. */
+    bool offload_data_available();
+
+    /* Invokes the data available listener. */
+    virtual void notify_data_available() {}
+
 private:
+    dds_return_t collect(
+            const dds_entity_t reader,
+            bool take,
+            dds_instance_handle_t handle,
+            uint32_t ddsc_mask,
+            dds::sub::detail::SamplesHolder& samples,
+            uint32_t requested_max_samples);
+
+    void collect_samples(
+            const dds_entity_t reader,
+            bool take,
+            dds_instance_handle_t handle,
+            const dds::sub::status::DataState& mask,
+            dds::sub::detail::SamplesHolder& samples,
+            uint32_t requested_max_samples);
+
+    /* Collects the samples of the instance with the smallest handle larger than
+     * handle that has samples matching mask, DDS_HANDLE_NIL starts at the first. */
+    void collect_next_instance(
+            const dds_entity_t reader,
+            bool take,
+            const dds::core::InstanceHandle& handle,
+            const dds::sub::status::DataState& mask,
+            dds::sub::detail::SamplesHolder& samples,
+            uint32_t requested_max_samples);
+
+    /* Finds the smallest handle larger than handle of the instances with samples
+     * matching ddsc_mask in a sorted snapshot of those instances. ddsc offers no way
+     * to enumerate the instances of a reader, so the snapshot is taken by peeking at
+     * all matching samples once, when an iteration starts at DDS_HANDLE_NIL, when it
+     * runs past the end of the snapshot and when the mask changes. Instances that
+     * arrive during an iteration with a handle before the end may be missed, which
+     * DDS allows, and instances in the snapshot that lost their samples are skipped
+     * by the caller. */
+    dds_return_t next_instance_handle(
+            const dds_entity_t reader,
+            dds_instance_handle_t handle,
+            uint32_t ddsc_mask,
+            dds_instance_handle_t& next);
+
+    dds_return_t refresh_instances(
+            const dds_entity_t reader,
+            uint32_t ddsc_mask);
+
     void fini_samples_buffers(
             void**& c_sample_pointers,
             dds_sample_info_t*& c_sample_infos);
 
+    uint32_t reserve_length(uint32_t requested_max_samples) const;
+
+    static uint32_t reserve_limit(const dds::sub::qos::DataReaderQos& qos);
+
+    /* Copy of the reserve limit following from qos_, which the data path
+     * reads without holding the object lock. */
+    std::atomic<uint32_t> reserve_limit_;
+
+    /* Accessed with the std::atomic_load/atomic_store overloads for shared_ptr. */
+    std::shared_ptr<const ParallelDeserialization> parallel_;
+
+    /* Accessed with the std::atomic_load/atomic_store overloads for shared_ptr. */
+    std::shared_ptr<const org::eclipse::cyclonedds::core::TaskExecutor> listener_executor_;
+
+    /* Data available notifications not yet handled, there is a task handed to
+     * the listener executor for them as long as this is not 0. */
+    std::atomic<uint32_t> data_available_pending_;
+
+    /* Snapshot of the handles of the instances with samples matching
+     * instances_mask_, sorted, for finding the next instance. */
+    org::eclipse::cyclonedds::core::Mutex instances_mutex_;
+    std::vector<dds_instance_handle_t> instances_;
+    uint32_t instances_mask_;
+    bool instances_valid_;
+
     static dds_return_t collector_callback_fn (
         void *arg,
         const dds_sample_info_t *si,
         const struct ddsi_sertype *,
         struct ddsi_serdata *sd);
 
+    static dds_return_t next_instance_callback_fn (
+        void *arg,
+        const dds_sample_info_t *si,
+        const struct ddsi_sertype *,
+        struct ddsi_serdata *);
+
 protected:
     org::eclipse::cyclonedds::core::ObjectSet queries;
     dds::sub::qos::DataReaderQos qos_;
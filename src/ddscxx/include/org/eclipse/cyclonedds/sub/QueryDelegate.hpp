@@ -21,6 +21,7 @@
 
 #include <org/eclipse/cyclonedds/core/DDScObjectDelegate.hpp>
 #include <org/eclipse/cyclonedds/core/Mutex.hpp>
+#include <org/eclipse/cyclonedds/topic/FilterExpression.hpp>
 
 
 #include <vector>
@@ -68,7 +69,7 @@ public:
 
     const std::string& expression() const;
 
-    void expression(const std::string& expr);
+    virtual void expression(const std::string& expr);
 
     iterator begin();
 
@@ -78,15 +79,15 @@ public:
 
     const_iterator end() const;
 
-    void add_parameter(const std::string& param);
+    virtual void add_parameter(const std::string& param);
 
     uint32_t parameters_length() const;
 
-    void parameters(const std::vector<std::string>& params);
+    virtual void parameters(const std::vector<std::string>& params);
 
     std::vector<std::string> parameters();
 
-    void clear_parameters();
+    virtual void clear_parameters();
 
     const dds::sub::AnyDataReader& data_reader() const;
 
@@ -98,15 +99,38 @@ public:
 
     bool state_filter_equal(dds::sub::status::DataState& s);
 
+    /* Internal API. */
+
+    /* Returns the ddsc query condition selecting the samples matching this query, it is
+     * (re)created when the query was modified since it was last used. Sets filter to
+     * the compiled expression the condition evaluates, to determine the instance all
+     * matching samples belong to, see FilterExpression::key(). */
+    virtual dds_entity_t query_condition(
+        std::shared_ptr<const org::eclipse::cyclonedds::topic::FilterExpression>& filter);
+
 protected:
     void deinit();
 
-private:
+    /* Compiles the expression and creates a ddsc query condition evaluating it. */
+    dds_entity_t create_query_condition();
+
+    /* Releases the compiled expression of a ddsc query condition that was replaced
+     * by a new one from create_query_condition(), after it was deleted. */
+    static void release_replaced_filter(size_t filter_slot);
+
+    /* Releases the compiled expression, after its ddsc query condition was deleted. */
+    void release_filter();
+
     dds::sub::AnyDataReader reader_;
     std::string expression_;
     std::vector<std::string> params_;
     dds::sub::status::DataState state_filter_;
     bool modified_;
+    std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> filter_;
+    size_t filter_slot_;
+
+private:
+    dds_entity_t query_;
 };
 
 
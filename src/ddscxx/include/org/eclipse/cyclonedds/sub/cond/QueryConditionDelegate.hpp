@@ -54,17 +54,28 @@ public:
 
     ~QueryConditionDelegate();
 
-    typedef bool (*Filter_fn) (const void * sample);
+    void init(ObjectDelegate::weak_ref_type weak_ref);
 
-    void set_filter(Filter_fn filter);
+    void close();
 
-    Filter_fn get_filter();
+    /* Changing the expression or parameters recreates the ddsc query condition, so
+     * that the change applies to the samples already in the reader too. Added
+     * parameters take effect once the expression has all the parameters it needs. */
+    using QueryDelegate::expression;
+    void expression(const std::string& expr);
 
-    void init(ObjectDelegate::weak_ref_type weak_ref);
-protected:
-    Filter_fn cpp_filter;
+    using QueryDelegate::parameters;
+    void parameters(const std::vector<std::string>& params);
+
+    void add_parameter(const std::string& param);
+
+    void clear_parameters();
+
+    dds_entity_t query_condition(
+        std::shared_ptr<const org::eclipse::cyclonedds::topic::FilterExpression>& filter);
 
-    static bool trans_filter(const void *csample, const void *ctx);
+private:
+    void recreate_query_condition();
 };
 
 }
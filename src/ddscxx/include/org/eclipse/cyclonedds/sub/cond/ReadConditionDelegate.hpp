@@ -50,6 +50,10 @@ public:
     void close();
 
     virtual bool trigger_value() const;
+
+protected:
+    /* For conditions creating a ddsc condition of their own. */
+    explicit ReadConditionDelegate(const dds::sub::AnyDataReader& dr);
 };
 
 }
@@ -0,0 +1,203 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_TOPIC_FILTER_EXPRESSION_HPP_
+#define CYCLONEDDS_TOPIC_FILTER_EXPRESSION_HPP_
+
+#include <dds/core/macros.hpp>
+#include <org/eclipse/cyclonedds/core/cdr/filter_members.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+DDSCXX_WARNING_MSVC_OFF(4251)
+
+/**
+ * @brief
+ * Filter expression, compiled into a program which only reads the members it references.
+ *
+ * Supports the DDS filter expression grammar: comparisons (=, <>, !=, <, <=, >, >=, LIKE)
+ * and [NOT] BETWEEN of members with literals, parameters (%0 to %99) and other members,
+ * combined with AND, OR, NOT and parentheses. Members of nested structs are referenced
+ * by their dot separated names, enums are compared by their integer values.
+ *
+ * The expression is parsed and its member names are resolved once, on construction.
+ * The parameters are converted to the kind of the members they are compared with, and
+ * can be replaced without recompiling the expression, also while samples are evaluated.
+ *
+ * The expression is evaluated on deserialized samples, not on their CDR: the topic and
+ * query filters of ddsc are only passed a sample, which ddsc first deserializes in full.
+ * Filtering does not save the cost of deserializing rejected samples.
+ */
+class OMG_DDS_API FilterExpression
+{
+public:
+    typedef bool (*Resolver)(const std::string& name, org::eclipse::cyclonedds::core::cdr::filter_field& field);
+    typedef org::eclipse::cyclonedds::core::cdr::filter_value (*Loader)(const void* sample, const org::eclipse::cyclonedds::core::cdr::filter_field& field);
+    typedef bool (*Storer)(void* sample, const org::eclipse::cyclonedds::core::cdr::filter_field& field, const org::eclipse::cyclonedds::core::cdr::filter_value& value);
+
+    /**
+     * @brief
+     * Compiles a filter expression.
+     *
+     * @param expression The filter expression.
+     * @param params The values of the parameters in the expression.
+     * @param resolve Looks up the members referenced by the expression.
+     * @param load Reads a member from a sample.
+     * @param store Writes a key member of a sample, if instances can be looked up.
+     * @param keys The number of key members of the type.
+     *
+     * @throws dds::core::InvalidArgumentError if the expression or a parameter is invalid.
+     */
+    FilterExpression(const std::string& expression, const std::vector<std::string>& params,
+                     Resolver resolve, Loader load, Storer store = nullptr, size_t keys = 0);
+
+    /**
+     * @brief
+     * Replaces the values of the parameters, without recompiling the expression.
+     *
+     * @throws dds::core::InvalidArgumentError if a parameter is missing or cannot be
+     *         converted to the kind of the members it is compared with.
+     */
+    void parameters(const std::vector<std::string>& params);
+
+    /**
+     * @brief
+     * Returns the number of parameters the expression needs, one more than the highest
+     * parameter number it references.
+     */
+    size_t required_parameters() const;
+
+    /**
+     * @brief
+     * Evaluates the expression on a sample.
+     */
+    bool matches(const void* sample) const;
+
+    /**
+     * @brief
+     * Determines the instance all matching samples belong to.
+     *
+     * This is the case when the expression is a conjunction in which every key member is
+     * compared for equality with a literal or parameter.
+     *
+     * @param sample The sample of which the key members are set to the values they are
+     *               compared with.
+     *
+     * @return Whether all key members of sample were set.
+     */
+    bool key(void* sample) const;
+
+    /**
+     * @brief
+     * Returns whether the expression compares every key member for equality, so that
+     * key() can determine the instance, without needing a sample to set them in.
+     */
+    bool fixes_key() const;
+
+private:
+    class Compiler;
+
+    struct Value
+    {
+        org::eclipse::cyclonedds::core::cdr::filter_value value;
+        std::string text;
+    };
+
+    struct Operand
+    {
+        enum Kind { FIELD, CONSTANT, PARAMETER };
+        Kind kind;
+        size_t index;
+    };
+
+    struct Node
+    {
+        enum Op { AND, OR, NOT, EQ, NE, LT, LE, GT, GE, LIKE, BETWEEN, NOT_BETWEEN };
+        Op op;
+        size_t lhs, rhs;
+        Operand x, y, z;
+    };
+
+    struct Slot
+    {
+        size_t param;
+        org::eclipse::cyclonedds::core::cdr::filter_kind kind;
+    };
+
+    typedef std::vector<Value> Values;
+
+    bool evaluate(size_t node, const void* sample, const Values& params) const;
+    org::eclipse::cyclonedds::core::cdr::filter_value get(const Operand& operand, const void* sample, const Values& params) const;
+    void key(size_t node, void* sample, const Values& params, std::vector<bool>& set, bool& ok) const;
+
+    std::vector<Node> nodes;
+    std::vector<org::eclipse::cyclonedds::core::cdr::filter_field> fields;
+    Values constants;
+    std::vector<Slot> slots;
+    std::shared_ptr<const Values> params_;
+    Loader load;
+    Storer store;
+    size_t keys;
+};
+
+/**
+ * @brief
+ * Filter expression on samples of type T, of which idlcxx generated the member lookup.
+ */
+template <typename T>
+class TypedFilterExpression : public FilterExpression
+{
+public:
+    TypedFilterExpression(const std::string& expression, const std::vector<std::string>& params)
+        : FilterExpression(expression, params, &org::eclipse::cyclonedds::core::cdr::filter_resolve<T>, &load_member,
+                           &store_member, org::eclipse::cyclonedds::core::cdr::filter_members<T>::keys())
+    {
+    }
+
+    bool matches(const T& sample) const
+    {
+        return FilterExpression::matches(&sample);
+    }
+
+private:
+    static org::eclipse::cyclonedds::core::cdr::filter_value load_member(const void* sample, const org::eclipse::cyclonedds::core::cdr::filter_field& field)
+    {
+        return org::eclipse::cyclonedds::core::cdr::filter_members<T>::load(*static_cast<const T*>(sample), field.path.data());
+    }
+
+    static bool store_member(void* sample, const org::eclipse::cyclonedds::core::cdr::filter_field& field, const org::eclipse::cyclonedds::core::cdr::filter_value& value)
+    {
+        return org::eclipse::cyclonedds::core::cdr::filter_members<T>::store(*static_cast<T*>(sample), field.path.data(), value);
+    }
+};
+
+DDSCXX_WARNING_MSVC_ON(4251)
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_TOPIC_FILTER_EXPRESSION_HPP_ */
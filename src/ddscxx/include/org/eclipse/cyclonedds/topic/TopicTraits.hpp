@@ -161,6 +161,23 @@ public:
         return extensibility::ext_final;
     }
 
+    /**
+     * @brief Returns whether received samples of TOPIC are deserialized only on access.
+     *
+     * Used on the receive path to determine whether the sample needs to be kept after
+     * the keyhash has been derived from it. When true, the keyhash is derived through a
+     * per-thread scratch sample (or not at all for keyless types), and the sample itself
+     * is only constructed once the application accesses the data. This trait is not
+     * generated, it can be specialized by the user for topics of which most samples are
+     * dropped before being read.
+     *
+     * @return Whether deserialization of TOPIC is deferred until first access.
+     */
+    static constexpr bool deferDeserialization()
+    {
+        return false;
+    }
+
 #ifdef DDSCXX_HAS_TYPELIB
     /**
      * @brief Returns the typeid for TOPIC.
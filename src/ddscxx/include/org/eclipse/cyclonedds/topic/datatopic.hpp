@@ -25,12 +25,34 @@
 #include "org/eclipse/cyclonedds/core/cdr/basic_cdr_ser.hpp"
 #include "org/eclipse/cyclonedds/core/cdr/extended_cdr_v1_ser.hpp"
 #include "org/eclipse/cyclonedds/core/cdr/extended_cdr_v2_ser.hpp"
+#include "org/eclipse/cyclonedds/core/cdr/cdr_view.hpp"
+#include "org/eclipse/cyclonedds/core/cdr/filter_members.hpp"
 #include "org/eclipse/cyclonedds/core/cdr/fragchain.hpp"
 #include "org/eclipse/cyclonedds/topic/TopicTraits.hpp"
 #include "org/eclipse/cyclonedds/topic/hash.hpp"
 
 constexpr size_t DDSI_RTPS_HEADER_SIZE = 4u;
 
+/* the size of the buffer on the stack used for serializing keys which do not fit
+ * in the keyhash, keys exceeding this size are serialized into a heap buffer */
+constexpr size_t DDSCXX_KEY_STACK_BUFFER_SIZE = 256u;
+
+/* the number of released serdata kept per sample type for reuse, and the range of
+ * payload buffer sizes which are kept along with them */
+constexpr size_t DDSCXX_SERDATA_CACHE_SIZE = 32u;
+constexpr size_t DDSCXX_SERDATA_CACHE_MIN_BUFFER = 64u;
+constexpr size_t DDSCXX_SERDATA_CACHE_MAX_BUFFER = 4096u;
+
+/* the size of the per-thread buffer into which samples are serialized before their
+ * size is known, samples which do not fit are sized separately */
+constexpr size_t DDSCXX_SERDATA_SCRATCH_SIZE = 4096u;
+
+/* serialized samples up to this size (including the encoding header) are stored
+ * in the serdata itself instead of in a separately allocated buffer */
+#ifndef DDSCXX_SERDATA_INLINE_SIZE
+#define DDSCXX_SERDATA_INLINE_SIZE 128u
+#endif
+
 #if DDSRT_ENDIAN == DDSRT_LITTLE_ENDIAN
 
 #define DDSI_RTPS_CDR_BE         0x0000u
@@ -82,6 +104,23 @@ using org::eclipse::cyclonedds::topic::TopicTraits;
 template<typename T, class S, key_mode K>
 bool get_serialized_size(const T& sample, size_t &sz);
 
+/// \brief Returns the maximum size of the big-endian serialized key of a type
+/// \param[in] sample A sample of the type, only used on the first invocation
+/// \tparam T The sample type
+/// \return The maximum key size, or SIZE_MAX if the key size is unbounded
+template<typename T>
+size_t get_key_max_size(const T& sample)
+{
+  //determined once per type, as this does not depend on the contents of the sample
+  static const size_t key_max_size = [&sample]() {
+    basic_cdr_stream str(endianness::big_endian);
+    if (!max(str, sample, key_mode::sorted))
+      return SIZE_MAX;
+    return str.position();
+  }();
+  return key_max_size;
+}
+
 template<typename T>
 bool to_key(const T& tokey, ddsi_keyhash_t& hash)
 {
@@ -92,41 +131,38 @@ bool to_key(const T& tokey, ddsi_keyhash_t& hash)
   } else
   {
     basic_cdr_stream str(endianness::big_endian);
+    if (get_key_max_size(tokey) <= sizeof(hash.value))
+    {
+      //the key always fits in the keyhash, so it is written directly into it
+      memset(&(hash.value), 0x0, sizeof(hash.value));
+      str.set_buffer(hash.value, sizeof(hash.value));
+      if (!write(str, tokey, key_mode::sorted)) {
+        assert(false);
+        return false;
+      }
+      return false;
+    }
+
+    //keys which are smaller than the keyhash are zero-padded before hashing
+    unsigned char buffer[DDSCXX_KEY_STACK_BUFFER_SIZE];
+    memset(buffer, 0x0, sizeof(hash.value));
+    str.set_buffer(buffer, sizeof(buffer));
+    if (write(str, tokey, key_mode::sorted))
+      return org::eclipse::cyclonedds::topic::complex_key(buffer, std::max(str.position(), sizeof(hash.value)), hash);
+
+    //the key does not fit in the buffer on the stack
     size_t sz = 0;
     if (!get_serialized_size<T, basic_cdr_stream, key_mode::sorted>(tokey, sz)) {
       assert(false);
       return false;
     }
-    size_t padding = 0;
-    if (sz < 16)
-      padding = (16 - sz % 16)%16;
-    std::vector<unsigned char> buffer(sz + padding);
-    if (padding)
-      memset(buffer.data() + sz, 0x0, padding);
-    str.set_buffer(buffer.data(), sz);
+    std::vector<unsigned char> heap_buffer(std::max(sz, sizeof(hash.value)), 0x0);
+    str.set_buffer(heap_buffer.data(), sz);
     if (!write(str, tokey, key_mode::sorted)) {
       assert(false);
       return false;
     }
-    static thread_local bool (*fptr)(const std::vector<unsigned char>&, ddsi_keyhash_t&) = NULL;
-    if (fptr == NULL)
-    {
-      if (!max(str, tokey, key_mode::sorted)) {
-        assert(false);
-        return false;
-      }
-      if (str.position() <= 16)
-      {
-        //bind to unmodified function which just copies buffer into the keyhash
-        fptr = &org::eclipse::cyclonedds::topic::simple_key;
-      }
-      else
-      {
-        //bind to MD5 hash function
-        fptr = &org::eclipse::cyclonedds::topic::complex_key;
-      }
-    }
-    return (*fptr)(buffer, hash);
+    return org::eclipse::cyclonedds::topic::complex_key(heap_buffer.data(), heap_buffer.size(), hash);
   }
 }
 
@@ -266,27 +302,39 @@ bool read_header(const void *buffer, encoding_version &ver, endianness &end)
 template<typename T, class S, key_mode K>
 bool get_serialized_fixed_size(const T& sample, size_t &sz)
 {
-  static thread_local size_t serialized_size = 0;
-  static thread_local std::mutex mtx;
-  static thread_local std::atomic_bool initialized {false};
-  if (initialized.load(std::memory_order_relaxed)) {
-    sz = serialized_size;
-    return true;
-  }
-  std::lock_guard<std::mutex> lock(mtx);
-  if (initialized.load(std::memory_order_relaxed)) {
-    sz = serialized_size;
-    return true;
+  //determined once per type, concurrent first invocations determine the same size
+  static std::atomic<size_t> serialized_size {SIZE_MAX};
+  size_t fixed_size = serialized_size.load(std::memory_order_relaxed);
+  if (fixed_size == SIZE_MAX) {
+    S str;
+    if (!move(str, sample, K))
+      return false;
+    fixed_size = str.position();
+    serialized_size.store(fixed_size, std::memory_order_relaxed);
   }
-  S str;
-  if (!move(str, sample, K))
-    return false;
-  serialized_size = str.position();
-  initialized.store(true, std::memory_order_release);
-  sz = serialized_size;
+  sz = fixed_size;
   return true;
 }
 
+/// \brief Returns the maximum serialized size of a type, excluding the encoding header
+/// \param[in] sample A sample of the type, only used on the first invocation
+/// \tparam T The sample type
+/// \tparam S The stream type
+/// \tparam K The key mode
+/// \return The maximum size, or SIZE_MAX if the size is unbounded
+template<typename T, class S, key_mode K>
+size_t get_serialized_max_size(const T& sample)
+{
+  //determined once per type, as this does not depend on the contents of the sample
+  static const size_t max_size = [&sample]() {
+    S str;
+    if (!max(str, sample, K))
+      return SIZE_MAX;
+    return str.position();
+  }();
+  return max_size;
+}
+
 template<typename T, class S, key_mode K>
 bool get_serialized_size(const T& sample, size_t &sz)
 {
@@ -331,6 +379,32 @@ bool serialize_into(void *buffer,
   return serialize_into_impl<T,S>(buffer,cdr_start,buf_sz, sample, mode);
 }
 
+/// \brief Serializes a sample into a buffer which may be larger than needed
+/// \param[in] buffer The buffer, including room for the encoding header
+/// \param[in] buf_sz The size of the buffer
+/// \param[in] sample The sample to serialize
+/// \param[in] mode The key mode to serialize with
+/// \param[out] written The number of bytes written, including the encoding header
+/// \return True if the sample was serialized, false if it failed or does not fit
+template<typename T, class S>
+bool serialize_into(void *buffer,
+                    size_t buf_sz,
+                    const T &sample,
+                    key_mode mode,
+                    size_t &written)
+{
+  CHECK_FOR_NULL(buffer);
+  assert(buf_sz >= DDSI_RTPS_HEADER_SIZE);
+
+  S str;
+  str.set_buffer(calc_offset(buffer, DDSI_RTPS_HEADER_SIZE), buf_sz - DDSI_RTPS_HEADER_SIZE);
+  if (!write_header<T,S>(buffer)
+   || !write(str, sample, mode))
+    return false;
+  written = DDSI_RTPS_HEADER_SIZE + str.position();
+  return finish_header<T>(buffer, written);
+}
+
 template <typename T, typename S>
 bool deserialize_sample_from_buffer_impl(void *buffer,
                                     size_t buf_sz,
@@ -376,7 +450,115 @@ bool deserialize_sample_from_buffer(void *buffer,
   }
 }
 
+/// \brief Locates the CDR data of a serialized sample, for viewing it in place
+/// \param[in] buffer The buffer containing the serialized sample, including the encoding header
+/// \param[in] buf_sz The size of the buffer
+/// \param[out] buf The CDR data in buffer
+/// \tparam T The sample type
+/// \return True if the encoding header of the buffer is valid for T
+///         False otherwise
+template <typename T>
+bool view_buffer_from_buffer(const void *buffer,
+                             size_t buf_sz,
+                             org::eclipse::cyclonedds::core::cdr::view_buffer &buf)
+{
+  CHECK_FOR_NULL(buffer);
+
+  encoding_version ver;
+  endianness end;
+  if (buf_sz < DDSI_RTPS_HEADER_SIZE || !read_header<T>(buffer, ver, end))
+    return false;
+
+  buf.buffer = static_cast<const unsigned char*>(buffer) + DDSI_RTPS_HEADER_SIZE;
+  buf.size = buf_sz - DDSI_RTPS_HEADER_SIZE;
+  buf.swap = end != native_endianness();
+  buf.version = ver;
+  return true;
+}
+
+/// \brief Reads the key members of a serialized data sample, without decoding its other members
+/// \param[in] buffer The buffer containing the serialized sample, including the encoding header
+/// \param[in] buf_sz The size of the buffer
+/// \param[out] sample The sample of which the key members are assigned
+/// \tparam T The sample type, which has a generated view on its key members
+/// \return True if the key members could be read
+template <typename T, DDSCXX_STD_IMPL::enable_if_t<org::eclipse::cyclonedds::core::cdr::has_view_keys<T>::value, bool> = true>
+bool read_key_from_data(void *buffer, size_t buf_sz, T &sample)
+{
+  org::eclipse::cyclonedds::core::cdr::view_buffer buf;
+  if (!view_buffer_from_buffer<T>(buffer, buf_sz, buf))
+    return false;
+
+  org::eclipse::cyclonedds::core::cdr::view<T> v(buf, 0);
+  if (!org::eclipse::cyclonedds::core::cdr::view_valid(v))
+    return false;
+
+  org::eclipse::cyclonedds::core::cdr::view_keys<T>::load(v, sample);
+  return true;
+}
+
+/// \brief Reads the key members of a serialized data sample of a type without a view on its key members
+///
+/// Such types (mutable types, or types with optional members or unions for example) are
+/// deserialized completely, as their non-key members cannot be skipped.
+template <typename T, DDSCXX_STD_IMPL::enable_if_t<!org::eclipse::cyclonedds::core::cdr::has_view_keys<T>::value, bool> = true>
+bool read_key_from_data(void *buffer, size_t buf_sz, T &sample)
+{
+  return deserialize_sample_from_buffer(buffer, buf_sz, sample, SDK_DATA);
+}
+
 template <typename T> class ddscxx_serdata;
+template <typename T> class ddscxx_serdata_cache;
+
+/// \brief Derives the key and hash of a received sample from its serialized contents
+/// \param[in,out] d The serdata containing the received sample
+/// \param[in] keep_sample Whether the deserialized sample is stored in the serdata
+/// \tparam T The sample type
+/// \return True if the key could be derived
+///         False if the serialized contents could not be deserialized
+template <typename T>
+bool serdata_populate_key_from_ser(ddscxx_serdata<T> *d, bool keep_sample = !TopicTraits<T>::deferDeserialization())
+{
+  if (keep_sample)
+  {
+    T* ptr = d->getT();
+    if (!ptr)
+      return false;
+    d->populate_hash(*ptr);
+    return true;
+  }
+
+  /* only the key members are read, into a per-thread scratch sample which is reused,
+   * and the sample stored in the serdata is only constructed when it is accessed,
+   * keyless types need no sample at all, and serialized keys contain only the keys */
+  static thread_local T scratch;
+  if (TopicTraits<T>::isKeyless())
+  {
+    encoding_version ver;
+    endianness end;
+    if (!read_header<T>(d->data(), ver, end))
+      return false;
+  }
+  else if (d->kind == SDK_DATA && !org::eclipse::cyclonedds::core::cdr::has_view_keys<T>::value)
+  {
+    /* without a view the whole sample is deserialized, which is not kept in the
+     * scratch sample, as that would retain the largest sample received on this thread */
+    T sample;
+    if (!read_key_from_data(d->data(), d->size(), sample))
+      return false;
+    d->populate_hash(sample);
+    return true;
+  }
+  else if (d->kind == SDK_KEY
+           ? !deserialize_sample_from_buffer(d->data(), d->size(), scratch, SDK_KEY)
+           : !read_key_from_data(d->data(), d->size(), scratch))
+  {
+    return false;
+  }
+
+  d->populate_hash(scratch);
+  return true;
+}
 
 template <typename T>
 bool serdata_eqkey(const ddsi_serdata* a, const ddsi_serdata* b)
@@ -400,19 +582,14 @@ ddsi_serdata *serdata_from_ser(
   const struct ddsi_rdata* fragchain,
   size_t size)
 {
-  auto d = new ddscxx_serdata<T>(type, kind);
+  auto d = ddscxx_serdata_cache<T>::get(type, kind);
   d->resize(size);
   auto cursor = static_cast<unsigned char*>(d->data());
   org::eclipse::cyclone::core::cdr::serdata_from_ser_copyin_fragchain (cursor, fragchain, size);
 
-  if (d->getT())
+  if (!serdata_populate_key_from_ser(d))
   {
-    d->key_md5_hashed() = to_key(*d->getT(), d->key());
-    d->populate_hash();
-  }
-  else
-  {
-    delete d;
+    ddscxx_serdata_cache<T>::put(d);
     d = nullptr;
   }
 
@@ -427,7 +604,7 @@ ddsi_serdata *serdata_from_ser_iov(
   const ddsrt_iovec_t* iov,
   size_t size)
 {
-  auto d = new ddscxx_serdata<T>(type, kind);
+  auto d = ddscxx_serdata_cache<T>::get(type, kind);
   d->resize(size);
 
   size_t off = 0;
@@ -441,12 +618,8 @@ ddsi_serdata *serdata_from_ser_iov(
     off += n_bytes;
   }
 
-  T* ptr = d->getT();
-  if (ptr) {
-    d->key_md5_hashed() = to_key(*ptr, d->key());
-    d->populate_hash();
-  } else {
-    delete d;
+  if (!serdata_populate_key_from_ser(d)) {
+    ddscxx_serdata_cache<T>::put(d);
     d = nullptr;
   }
 
@@ -454,6 +627,36 @@ ddsi_serdata *serdata_from_ser_iov(
 
 }
 
+/// \brief Creates a serdata which takes over the buffer of a serialized sample
+/// \param[in] type The sertype of the serdata
+/// \param[in] kind The kind of the serialized sample
+/// \param[in,out] buffer The serialized sample, including the encoding header, moved into the serdata,
+///                       its size must be a multiple of 4, including the padding indicated in its header
+/// \tparam T The sample type
+/// \return The serdata, or nullptr if the key could not be derived from the serialized sample
+///         or if the buffer is not padded, a buffer that is not padded is left untouched
+template <typename T>
+ddsi_serdata *serdata_from_ser_adopt(
+  const ddsi_sertype* type,
+  enum ddsi_serdata_kind kind,
+  std::vector<uint8_t>&& buffer)
+{
+  //padding the buffer could reallocate it, which would defeat adopting it
+  if (buffer.size() < DDSI_RTPS_HEADER_SIZE || buffer.size() % 4 != 0)
+    return nullptr;
+
+  auto d = ddscxx_serdata_cache<T>::get(type, kind);
+  d->adopt(std::move(buffer));
+
+  //the sample is only forwarded, so it is not kept after deriving the key
+  if (!serdata_populate_key_from_ser(d, false)) {
+    ddscxx_serdata_cache<T>::put(d);
+    d = nullptr;
+  }
+
+  return d;
+}
+
 template <typename T>
 ddsi_serdata *serdata_from_keyhash(
   const ddsi_sertype* type,
@@ -465,6 +668,51 @@ ddsi_serdata *serdata_from_keyhash(
   return nullptr;
 }
 
+/// \brief Per-thread buffer into which samples are serialized before their size is known
+/// \return The buffer, of DDSCXX_SERDATA_SCRATCH_SIZE bytes
+inline unsigned char *serdata_scratch_buffer()
+{
+  alignas(8) static thread_local unsigned char buffer[DDSCXX_SERDATA_SCRATCH_SIZE];
+  return buffer;
+}
+
+/// \brief Serializes a sample into the buffer of a serdata
+/// \param[in,out] d The serdata, its buffer is resized to the serialized sample
+/// \param[in] sample The sample to serialize
+/// \tparam K The key mode to serialize with
+/// \return True if the sample was serialized
+template <typename T, class S, key_mode K>
+bool serialize_into_serdata(ddscxx_serdata<T> *d, const T &sample)
+{
+  size_t sz = 0;
+  if (TopicTraits<T>::isSelfContained()) {
+    if (!get_serialized_fixed_size<T,S,K>(sample, sz))
+      return false;
+    sz += DDSI_RTPS_HEADER_SIZE;
+    d->resize(sz);
+    return serialize_into<T,S>(d->data(), sz, sample, K);
+  }
+
+  //other samples are written in a single pass into the scratch buffer and copied into
+  //a buffer of their size, they are only sized separately if they do not fit, which is
+  //an error if the maximum size of their type fits
+  unsigned char *scratch = serdata_scratch_buffer();
+  size_t written = 0;
+  if (serialize_into<T,S>(scratch, DDSCXX_SERDATA_SCRATCH_SIZE, sample, K, written)) {
+    d->resize(written);
+    memcpy(d->data(), scratch, written);
+    return true;
+  } else if (get_serialized_max_size<T,S,K>(sample) <= DDSCXX_SERDATA_SCRATCH_SIZE - DDSI_RTPS_HEADER_SIZE) {
+    return false;
+  }
+
+  if (!get_serialized_size<T,S,K>(sample, sz))
+    return false;
+  sz += DDSI_RTPS_HEADER_SIZE;
+  d->resize(sz);
+  return serialize_into<T,S>(d->data(), sz, sample, K);
+}
+
 template <typename T, class S>
 ddsi_serdata *serdata_from_sample(
   const ddsi_sertype* typecmn,
@@ -472,19 +720,11 @@ ddsi_serdata *serdata_from_sample(
   const void* sample)
 {
   assert(kind != SDK_EMPTY);
-  auto d = new ddscxx_serdata<T>(typecmn, kind);
+  auto d = ddscxx_serdata_cache<T>::get(typecmn, kind);
   const auto& msg = *static_cast<const T*>(sample);
-  size_t sz = 0;
-  const bool k = (kind == SDK_KEY);
 
-  if ((k && !get_serialized_size<T,S,key_mode::unsorted>(msg, sz)) ||
-      (!k && !get_serialized_size<T,S,key_mode::not_key>(msg, sz)))
-    goto failure;
-
-  sz += DDSI_RTPS_HEADER_SIZE;
-  d->resize(sz);
-
-  if (!serialize_into<T,S>(d->data(), sz, msg, k ? key_mode::unsorted : key_mode::not_key))
+  if ((kind == SDK_KEY && !serialize_into_serdata<T,S,key_mode::unsorted>(d, msg)) ||
+      (kind != SDK_KEY && !serialize_into_serdata<T,S,key_mode::not_key>(d, msg)))
     goto failure;
 
   d->key_md5_hashed() = to_key(msg, d->key());
@@ -494,7 +734,7 @@ ddsi_serdata *serdata_from_sample(
 
 failure:
   if (d)
-    delete d;
+    ddscxx_serdata_cache<T>::put(d);
   return nullptr;
 }
 
@@ -536,6 +776,12 @@ bool serdata_to_sample(
   // is actually const, we only modify the ddscxx_serdata non const contents
   auto d = const_cast<ddscxx_serdata<T>*>(static_cast<const ddscxx_serdata<T>*>(dcmn));
 
+  /* ddsc converts received samples through here to evaluate content filters and query
+   * filters, which are mostly rejected on topics that defer deserialization: deserialize
+   * straight into the destination, instead of keeping a copy in the serdata. */
+  if (TopicTraits<T>::deferDeserialization() && !d->hasT())
+    return deserialize_sample_from_buffer(d->data(), d->size(), *typed_sample_ptr, d->kind);
+
   auto t_ptr = d->getT();
   if (!t_ptr)
     return false;
@@ -552,7 +798,7 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
    * ddsi_serdata is not violated.
    */
   auto d = const_cast<ddscxx_serdata<T>*>(static_cast<const ddscxx_serdata<T>*>(dcmn));
-  auto d1 = new ddscxx_serdata<T>(d->type, SDK_KEY);
+  auto d1 = ddscxx_serdata_cache<T>::get(d->type, SDK_KEY);
   d1->type = nullptr;
 
   const T* t;
@@ -560,14 +806,7 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
     t = static_cast<const T*>(d->loan->sample_ptr);
   else
     t = d->getT();
-  size_t sz = 0;
-  if (t == nullptr || !get_serialized_size<T,S,key_mode::unsorted>(*t, sz))
-    goto failure;
-
-  sz += DDSI_RTPS_HEADER_SIZE;
-  d1->resize(sz);
-
-  if (!serialize_into<T,S>(d1->data(), sz, *t, key_mode::unsorted))
+  if (t == nullptr || !serialize_into_serdata<T,S,key_mode::unsorted>(d1, *t))
     goto failure;
 
   d1->key_md5_hashed() = to_key(*t, d1->key());
@@ -576,7 +815,7 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
   return d1;
 
 failure:
-  delete d1;
+  ddscxx_serdata_cache<T>::put(d1);
   return nullptr;
 }
 
@@ -599,7 +838,7 @@ bool serdata_untyped_to_sample(
 template <typename T>
 void serdata_free(ddsi_serdata* dcmn)
 {
-  delete static_cast<ddscxx_serdata<T>*>(dcmn);
+  ddscxx_serdata_cache<T>::put(static_cast<ddscxx_serdata<T>*>(dcmn));
 }
 
 template <typename T>
@@ -662,7 +901,7 @@ struct ddsi_serdata* serdata_from_loaned_sample (
   ddscxx_serdata<T> *d;
 
   if (!serialize_data)
-    d = new ddscxx_serdata<T>(type, kind);
+    d = ddscxx_serdata_cache<T>::get(type, kind);
   else
     d = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, S>(type, kind, sample));
   if (d == nullptr)
@@ -715,7 +954,7 @@ struct ddsi_serdata* serdata_from_psmx (
       return nullptr;
   }
 
-  ddscxx_serdata<T> *d = new ddscxx_serdata<T>(type, kind);
+  ddscxx_serdata<T> *d = ddscxx_serdata_cache<T>::get(type, kind);
   if (DDS_LOANED_SAMPLE_STATE_RAW_DATA != md->sample_state && DDS_LOANED_SAMPLE_STATE_RAW_KEY != md->sample_state)
   {
     bool deser_result = false;
@@ -737,7 +976,7 @@ struct ddsi_serdata* serdata_from_psmx (
     }
     if (!deser_result)  //deserialization unsuccesful, abort
     {
-      delete d;
+      ddscxx_serdata_cache<T>::put(d);
       return nullptr;
     }
   }
@@ -782,7 +1021,11 @@ struct ddscxx_serdata_ops: public ddsi_serdata_ops {
 template <typename T>
 class ddscxx_serdata : public ddsi_serdata {
   size_t m_size{ 0 };
-  std::unique_ptr<unsigned char[]> m_data{ nullptr };
+  size_t m_capacity{ 0 };
+  unsigned char* m_data{ nullptr };
+  std::unique_ptr<unsigned char[]> m_buffer{ nullptr };
+  std::vector<uint8_t> m_adopted;
+  alignas(8) unsigned char m_inline[DDSCXX_SERDATA_INLINE_SIZE];
   ddsi_keyhash_t m_key;
   bool m_key_md5_hashed = false;
   std::atomic<T *> m_t;  //use a recursive mutex and do all modifications inside it?
@@ -792,8 +1035,13 @@ public:
   ddscxx_serdata(const ddsi_sertype* type, ddsi_serdata_kind kind);
   ~ddscxx_serdata();
   void resize(size_t requested_size);
+  void adopt(std::vector<uint8_t>&& buffer);
+  void release_adopted();
+  void reinit(const ddsi_sertype* type, ddsi_serdata_kind kind);
+  void release_sample();
   size_t size() const { return m_size; }
-  void* data() const { return m_data.get(); }
+  size_t capacity() const { return m_capacity; }
+  void* data() const { return m_data; }
   ddsi_keyhash_t& key() { return m_key; }
   const ddsi_keyhash_t& key() const { return m_key; }
   bool& key_md5_hashed() { return m_key_md5_hashed; }
@@ -802,6 +1050,7 @@ public:
   void populate_hash();
   T* setT(const T* toset);
   T* getT(bool force_deserialization = true);
+  bool hasT() const { return m_t.load(std::memory_order_acquire) != nullptr; }
   void setLoan(dds_loaned_sample_t *newloan);
 
 private:
@@ -819,11 +1068,31 @@ ddscxx_serdata<T>::ddscxx_serdata(const ddsi_sertype* type, ddsi_serdata_kind ki
 template <typename T>
 ddscxx_serdata<T>::~ddscxx_serdata()
 {
-  T* t = m_t.load(std::memory_order_acquire);
+  release_sample();
+}
+
+template <typename T>
+void ddscxx_serdata<T>::reinit(const ddsi_sertype* type, ddsi_serdata_kind kind)
+{
+  assert(!m_t.load(std::memory_order_relaxed) && !loan);
+  *static_cast<ddsi_serdata*>(this) = ddsi_serdata{};
+  m_size = 0;
+  m_data = nullptr;
+  memset(m_key.value, 0x0, 16);
+  m_key_md5_hashed = false;
+  hash_populated = false;
+  ddsi_serdata_init(this, type, kind);
+}
+
+template <typename T>
+void ddscxx_serdata<T>::release_sample()
+{
+  T* t = m_t.exchange(nullptr, std::memory_order_acq_rel);
   if (!loan || loan->sample_ptr != t)
     delete t;
   if (loan)
     dds_loaned_sample_unref (loan);
+  loan = nullptr;
 }
 
 template <typename T>
@@ -831,18 +1100,60 @@ void ddscxx_serdata<T>::resize(size_t requested_size)
 {
   if (!requested_size) {
     m_size = 0;
-    m_data.reset();
+    m_capacity = 0;
+    m_data = nullptr;
+    m_buffer.reset();
     return;
   }
 
   /* FIXME: CDR padding in DDSI makes me do this to avoid reading beyond the bounds
   when copying data to network.  Should fix Cyclone to handle that more elegantly.  */
   size_t n_pad_bytes = (0 - requested_size) % 4;
-  m_data.reset(new unsigned char[requested_size + n_pad_bytes]);
   m_size = requested_size + n_pad_bytes;
+  if (m_size <= sizeof(m_inline)) {
+    //small payloads are stored in the serdata itself, a live serdata does not keep a buffer
+    m_data = m_inline;
+    m_capacity = 0;
+    m_buffer.reset();
+  } else if (m_size > m_capacity || m_size <= m_capacity / 2) {
+    /* buffers which can be kept when the serdata is recycled are rounded up to the
+       next power of two, so that they can be reused for samples of similar size,
+       a kept buffer more than twice the size of the payload is not reused */
+    m_capacity = m_size;
+    if (m_capacity <= DDSCXX_SERDATA_CACHE_MAX_BUFFER) {
+      m_capacity = DDSCXX_SERDATA_CACHE_MIN_BUFFER;
+      while (m_capacity < m_size)
+        m_capacity <<= 1;
+    }
+    m_buffer.reset(new unsigned char[m_capacity]);
+    m_data = m_buffer.get();
+  } else {
+    m_data = m_buffer.get();
+  }
 
   // zero the very end. The caller isn't necessarily going to overwrite it.
-  std::memset(calc_offset(m_data.get(), static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
+  std::memset(calc_offset(m_data, static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
+}
+
+template <typename T>
+void ddscxx_serdata<T>::adopt(std::vector<uint8_t>&& buffer)
+{
+  //the buffer is already padded to a multiple of 4 bytes, as checked by serdata_from_ser_adopt
+  assert(buffer.size() % 4 == 0);
+  m_adopted = std::move(buffer);
+  m_size = m_adopted.size();
+  m_data = m_adopted.data();
+}
+
+template <typename T>
+void ddscxx_serdata<T>::release_adopted()
+{
+  //adopted buffers are owned by a single serdata, so they are not kept for reuse
+  if (m_data == m_adopted.data()) {
+    m_size = 0;
+    m_data = nullptr;
+  }
+  std::vector<uint8_t>().swap(m_adopted);
 }
 
 template <typename T>
@@ -942,6 +1253,112 @@ void ddscxx_serdata<T>::setLoan(dds_loaned_sample_t *newloan)
   loan = newloan;
 }
 
+/**
+ * @brief Cache of released serdata of sample type T, shared by all threads.
+ *
+ * Released serdata are kept, together with their payload buffers, for reuse by the
+ * next serdata of the same sample type. This removes the allocations of the serdata
+ * and its payload buffer from the write and receive paths once they reach a steady
+ * state. Serdata are mostly released on another thread than they were created on:
+ * received samples are created on the receive thread and released by the application
+ * when it takes them, written samples are released by the thread handling the
+ * acknowledgements when they are retained for reliability. The cache is therefore
+ * shared, so that these serdata are reused by the thread creating the next ones.
+ *
+ * It is kept per sample type instead of per sertype, as serdata can still be released
+ * after their sertype was freed, for example when the application keeps samples of a
+ * deleted reader. The cache is a fixed number of slots which are claimed and released
+ * through atomic operations only. Slots are filled from the front and emptied from the
+ * back, so that without contention the most recently released serdata is reused first.
+ * Payload buffers larger than DDSCXX_SERDATA_CACHE_MAX_BUFFER are not kept.
+ */
+template <typename T>
+class ddscxx_serdata_cache
+{
+public:
+  static ddscxx_serdata<T>* get(const ddsi_sertype* type, ddsi_serdata_kind kind);
+  static void put(ddscxx_serdata<T>* d);
+
+private:
+  ddscxx_serdata_cache();
+  ~ddscxx_serdata_cache();
+  static ddscxx_serdata_cache* instance();
+  static bool& destroyed();
+
+  std::atomic<ddscxx_serdata<T>*> m_entries[DDSCXX_SERDATA_CACHE_SIZE];
+};
+
+template <typename T>
+ddscxx_serdata_cache<T>::ddscxx_serdata_cache()
+{
+  for (auto &e : m_entries)
+    e.store(nullptr, std::memory_order_relaxed);
+}
+
+template <typename T>
+ddscxx_serdata_cache<T>::~ddscxx_serdata_cache()
+{
+  destroyed() = true;
+  for (auto &e : m_entries)
+    delete e.exchange(nullptr, std::memory_order_acquire);
+}
+
+template <typename T>
+bool& ddscxx_serdata_cache<T>::destroyed()
+{
+  //trivially destructible, so it remains accessible while the program is exiting
+  static bool flag = false;
+  return flag;
+}
+
+template <typename T>
+ddscxx_serdata_cache<T>* ddscxx_serdata_cache<T>::instance()
+{
+  //serdata can still be released by the destructors of other static objects
+  if (destroyed())
+    return nullptr;
+  static ddscxx_serdata_cache cache;
+  return &cache;
+}
+
+template <typename T>
+ddscxx_serdata<T>* ddscxx_serdata_cache<T>::get(const ddsi_sertype* type, ddsi_serdata_kind kind)
+{
+  auto c = instance();
+  if (c) {
+    for (size_t i = DDSCXX_SERDATA_CACHE_SIZE; i-- > 0; ) {
+      auto &e = c->m_entries[i];
+      if (e.load(std::memory_order_relaxed) == nullptr)
+        continue;
+      auto d = e.exchange(nullptr, std::memory_order_acquire);
+      if (d) {
+        d->reinit(type, kind);
+        return d;
+      }
+    }
+  }
+  return new ddscxx_serdata<T>(type, kind);
+}
+
+template <typename T>
+void ddscxx_serdata_cache<T>::put(ddscxx_serdata<T>* d)
+{
+  auto c = instance();
+  if (c) {
+    d->release_sample();
+    d->release_adopted();
+    if (d->capacity() > DDSCXX_SERDATA_CACHE_MAX_BUFFER)
+      d->resize(0);
+    for (auto &e : c->m_entries) {
+      ddscxx_serdata<T>* exp = nullptr;
+      if (e.load(std::memory_order_relaxed) == nullptr
+       && e.compare_exchange_strong(exp, d, std::memory_order_release, std::memory_order_relaxed))
+        return;
+    }
+  }
+  delete d;
+}
+
 template <typename T, class S>
 class ddscxx_sertype;
 
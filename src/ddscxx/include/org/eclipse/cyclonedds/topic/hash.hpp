@@ -31,6 +31,8 @@ namespace org
         bool OMG_DDS_API simple_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out);
 
         bool OMG_DDS_API complex_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out);
+
+        bool OMG_DDS_API complex_key(const unsigned char* in, size_t sz, ddsi_keyhash_t& out);
       }
     }
   }
@@ -17,11 +17,31 @@
 #include <org/eclipse/cyclonedds/core/DDScObjectDelegate.hpp>
 #include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
 #include "org/eclipse/cyclonedds/core/Mutex.hpp"
+#include "org/eclipse/cyclonedds/core/ScopedLock.hpp"
 
-org::eclipse::cyclonedds::core::DDScObjectDelegate::entity_map_type
-org::eclipse::cyclonedds::core::DDScObjectDelegate::entity_map;
+namespace {
 
-org::eclipse::cyclonedds::core::Mutex org::eclipse::cyclonedds::core::DDScObjectDelegate::entity_map_mutex;
+/* The entity map is split into shards, each with its own lock, so that entities
+ * created, deleted and looked up from different threads rarely contend. */
+const uint32_t entity_map_shard_bits = 6;
+
+struct alignas(64) entity_map_shard
+{
+    org::eclipse::cyclonedds::core::Mutex mutex;
+    org::eclipse::cyclonedds::core::DDScObjectDelegate::entity_map_type map;
+};
+
+entity_map_shard entity_map[1u << entity_map_shard_bits];
+
+entity_map_shard&
+entity_map_shard_of(dds_entity_t e)
+{
+    /* Fibonacci hashing, as the handles are not guaranteed to be evenly spread over the low bits. */
+    const uint32_t h = static_cast<uint32_t>(e) * 2654435761u;
+    return entity_map[h >> (32 - entity_map_shard_bits)];
+}
+
+}
 
 org::eclipse::cyclonedds::core::DDScObjectDelegate::DDScObjectDelegate () :
     ddsc_entity(0)
@@ -44,9 +64,11 @@ org::eclipse::cyclonedds::core::DDScObjectDelegate::close ()
 {
     delete_from_entity_map();
 
-    if (this->ddsc_entity > 0) {
-        dds_delete(this->ddsc_entity);
-        this->ddsc_entity = 0;
+    /* Clear the handle before deleting the entity, so that concurrent users
+     * get an invalid handle rather than one that is being deleted. */
+    dds_entity_t e = this->ddsc_entity.exchange(0, std::memory_order_acq_rel);
+    if (e > 0) {
+        dds_delete(e);
     }
 
     org::eclipse::cyclonedds::core::ObjectDelegate::close();
@@ -55,21 +77,13 @@ org::eclipse::cyclonedds::core::DDScObjectDelegate::close ()
 dds_entity_t
 org::eclipse::cyclonedds::core::DDScObjectDelegate::get_ddsc_entity ()
 {
-    dds_entity_t handle;
-
-    this->lock();
-    handle = this->ddsc_entity;
-    this->unlock();
-
-    return handle;
+    return this->ddsc_entity.load(std::memory_order_acquire);
 }
 
 void
 org::eclipse::cyclonedds::core::DDScObjectDelegate::set_ddsc_entity (dds_entity_t e)
 {
-    this->lock();
-    this->ddsc_entity = e;
-    this->unlock();
+    this->ddsc_entity.store(e, std::memory_order_release);
 }
 
 void
@@ -77,16 +91,15 @@ org::eclipse::cyclonedds::core::DDScObjectDelegate::add_to_entity_map(org::eclip
 {
     // can be used without lock; only called from wrapper function constructor
 
-    DDScObjectDelegate::entity_map_mutex.lock ();
-    DDScObjectDelegate::entity_map[this->ddsc_entity] = weak_ref;
+    entity_map_shard& shard = entity_map_shard_of(this->ddsc_entity);
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(shard.mutex);
+    shard.map[this->ddsc_entity] = weak_ref;
 
 #ifndef NDEBUG
-    DDScObjectDelegate::entity_map_type::iterator it = DDScObjectDelegate::entity_map.find(this->ddsc_entity);
+    DDScObjectDelegate::entity_map_type::iterator it = shard.map.find(this->ddsc_entity);
 
-    assert(it != DDScObjectDelegate::entity_map.end());
+    assert(it != shard.map.end());
 #endif
-
-    DDScObjectDelegate::entity_map_mutex.unlock ();
 }
 
 void
@@ -95,12 +108,12 @@ org::eclipse::cyclonedds::core::DDScObjectDelegate::delete_from_entity_map()
     // can be used without lock; only called from wrapper function destructor
 
     if (this->ddsc_entity > 0) {
-        DDScObjectDelegate::entity_map_mutex.lock ();
-        DDScObjectDelegate::entity_map_type::iterator it = DDScObjectDelegate::entity_map.find(this->ddsc_entity);
-        if (it != DDScObjectDelegate::entity_map.end()) {
-            DDScObjectDelegate::entity_map.erase(it);
+        entity_map_shard& shard = entity_map_shard_of(this->ddsc_entity);
+        org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(shard.mutex);
+        DDScObjectDelegate::entity_map_type::iterator it = shard.map.find(this->ddsc_entity);
+        if (it != shard.map.end()) {
+            shard.map.erase(it);
         }
-        DDScObjectDelegate::entity_map_mutex.unlock ();
     }
 }
 
@@ -109,16 +122,16 @@ org::eclipse::cyclonedds::core::DDScObjectDelegate::extract_strong_ref (dds_enti
 {
     org::eclipse::cyclonedds::core::ObjectDelegate::weak_ref_type e_ptr;
 
-    DDScObjectDelegate::entity_map_mutex.lock ();
-    DDScObjectDelegate::entity_map_type::iterator it = DDScObjectDelegate::entity_map.find(e);
+    {
+        entity_map_shard& shard = entity_map_shard_of(e);
+        org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(shard.mutex);
+        DDScObjectDelegate::entity_map_type::iterator it = shard.map.find(e);
 
-    assert (it != DDScObjectDelegate::entity_map.end());
+        assert (it != shard.map.end());
 
-    e_ptr = it->second;
-
-    DDScObjectDelegate::entity_map_mutex.unlock ();
+        e_ptr = it->second;
+    }
 
     // coverity[return_local_addr_alias:FALSE]
     return e_ptr.lock();
 }
-
@@ -27,6 +27,13 @@
 
 #include <cassert>
 
+namespace {
+
+/* Set in callback_count once no further callbacks are allowed to start. */
+const long callbacks_prevented = 1L << 30;
+
+}
+
 org::eclipse::cyclonedds::core::ListenerArg::ListenerArg(EntityDelegate *cpp_ref_, bool reset_on_invoke_) :
     cpp_ref(cpp_ref_), reset_on_invoke(reset_on_invoke_)
 {
@@ -44,7 +51,7 @@ org::eclipse::cyclonedds::core::EntityDelegate::EntityDelegate() :
   ddsrt_mutex_init (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
   ddsrt_cond_init (static_cast<ddsrt_cond_t*>(this->callback_cond));
 
-  callback_count = 0;
+  callback_count.store (0, std::memory_order_relaxed);
 }
 
 org::eclipse::cyclonedds::core::EntityDelegate::~EntityDelegate()
@@ -247,9 +254,10 @@ void * org::eclipse::cyclonedds::core::EntityDelegate::listener_get () const
 
 void org::eclipse::cyclonedds::core::EntityDelegate::prevent_callbacks ()
 {
-  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  /* No callbacks start once the flag is set, the callbacks in progress are waited for. */
+  long count = this->callback_count.fetch_or (callbacks_prevented, std::memory_order_acq_rel);
 
-  if (this->get_weak_ref().expired () && (this->callback_count == 1))
+  if (this->get_weak_ref().expired () && ((count & ~callbacks_prevented) == 1))
   {
     // This condition leads to deadlock: the thread is a callback
     // thread, it has held the last reference to this object, the
@@ -264,41 +272,37 @@ void org::eclipse::cyclonedds::core::EntityDelegate::prevent_callbacks ()
     assert (false);
   }
 
-  while (callback_count > 0)
+  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+  while ((this->callback_count.load (std::memory_order_acquire) & ~callbacks_prevented) > 0)
   {
     ddsrt_cond_wait (static_cast<ddsrt_cond_t*>(this->callback_cond), static_cast<ddsrt_mutex_t*>(this->callback_mutex));
   }
-  callback_count = -1;
-
   ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
 }
 
 bool org::eclipse::cyclonedds::core::EntityDelegate::obtain_callback_lock ()
 {
-  bool result = false;
+  long count = this->callback_count.load (std::memory_order_relaxed);
 
-  ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
-  if (callback_count >= 0)
+  do
   {
-    result = true;
-    ++callback_count;
-  }
-  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
+    if (count & callbacks_prevented)
+      return false;
+  } while (!this->callback_count.compare_exchange_weak (count, count + 1, std::memory_order_acquire, std::memory_order_relaxed));
 
-  return result;
+  return true;
 }
 
 void org::eclipse::cyclonedds::core::EntityDelegate::release_callback_lock ()
 {
-    ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
-
-  --callback_count;
-  if (callback_count == 0)
+  /* Only the last callback that finishes while callbacks are being prevented
+   * needs to wake up the waiting thread, all others just decrement the count. */
+  if (this->callback_count.fetch_sub (1, std::memory_order_acq_rel) == (callbacks_prevented | 1))
   {
+    ddsrt_mutex_lock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
     ddsrt_cond_broadcast (static_cast<ddsrt_cond_t*>(this->callback_cond));
+    ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
   }
-
-  ddsrt_mutex_unlock (static_cast<ddsrt_mutex_t*>(this->callback_mutex));
 }
 
 const dds::core::status::StatusMask
@@ -25,8 +25,10 @@ org::eclipse::cyclonedds::core::ObjectDelegate::~ObjectDelegate ()
 
 void org::eclipse::cyclonedds::core::ObjectDelegate::check () const
 {
-  /* This method is not-thread-safe, and should only be used with a lock. */
-  if (closed) {
+  /* Closing is atomic, so this can be used without the lock. It only tells
+   * whether the object was closed at the time of the call though, operations
+   * that must not overlap with close() still need the lock. */
+  if (closed.load(std::memory_order_acquire)) {
     ISOCPP_THROW_EXCEPTION (ISOCPP_ALREADY_CLOSED_ERROR, "Trying to invoke an oparation on an object that was already closed");
   }
 }
@@ -52,7 +54,7 @@ void org::eclipse::cyclonedds::core::ObjectDelegate::unlock () const
 
 void org::eclipse::cyclonedds::core::ObjectDelegate::close ()
 {
-  this->closed = true;
+  this->closed.store(true, std::memory_order_release);
 }
 
 void org::eclipse::cyclonedds::core::ObjectDelegate::set_weak_ref (const ObjectDelegate::weak_ref_type &weak_ref)
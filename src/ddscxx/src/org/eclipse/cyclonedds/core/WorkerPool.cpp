@@ -0,0 +1,241 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/core/WorkerPool.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace core
+{
+
+class WorkerPool::Impl
+{
+public:
+    /* The workers share ownership of the pool, so that a task may destroy the
+     * WorkerPool it runs on: its own thread is then detached rather than joined,
+     * and frees the pool when it returns. */
+    static void start(const std::shared_ptr<Impl>& self, size_t nthreads)
+    {
+        for (size_t i = 0; i < nthreads; i++)
+            self->threads.emplace_back(&Impl::worker, self);
+    }
+
+    void shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        work_cv.notify_all();
+        for (auto &t: threads) {
+            if (t.get_id() == std::this_thread::get_id())
+                t.detach();
+            else
+                t.join();
+        }
+    }
+
+    bool has_threads() const
+    {
+        return !threads.empty();
+    }
+
+    void run(size_t count, const std::function<void(size_t)>& fn)
+    {
+        /* Waiting for the tasks from one of the tasks would wait for itself. */
+        if (current == this) {
+            ISOCPP_THROW_EXCEPTION(ISOCPP_PRECONDITION_NOT_MET_ERROR,
+                "WorkerPool::run called from a task executing on the same pool.");
+        }
+        Running running(this);
+        std::lock_guard<std::mutex> run_lock(run_mtx);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            task = &fn;
+            ntasks = count;
+            next.store(0, std::memory_order_relaxed);
+            active = threads.size();
+            error = nullptr;
+            generation++;
+        }
+        work_cv.notify_all();
+
+        execute();
+
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [this] { return active == 0; });
+        task = nullptr;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void post(std::function<void()>&& fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back(std::move(fn));
+        }
+        work_cv.notify_one();
+    }
+
+private:
+    /* Marks the calling thread as executing tasks of the pool. */
+    class Running
+    {
+    public:
+        explicit Running(const Impl *pool) : previous(current)
+        {
+            current = pool;
+        }
+
+        ~Running()
+        {
+            current = previous;
+        }
+
+    private:
+        const Impl *previous;
+    };
+
+    /* Executes tasks until all have been handed out. */
+    void execute()
+    {
+        size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < ntasks) {
+            try {
+                (*task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+
+    static void worker(std::shared_ptr<Impl> self)
+    {
+        Running running(self.get());
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(self->mtx);
+        for (;;) {
+            self->work_cv.wait(lock, [&self, seen] {
+                return self->stop || self->generation != seen || !self->queue.empty();
+            });
+            if (self->stop)
+                return;
+            if (self->generation != seen) {
+                seen = self->generation;
+                lock.unlock();
+                self->execute();
+                lock.lock();
+                if (--self->active == 0)
+                    self->done_cv.notify_one();
+            } else {
+                std::function<void()> fn = std::move(self->queue.front());
+                self->queue.pop_front();
+                lock.unlock();
+                try {
+                    fn();
+                } catch (...) {
+                }
+                /* Releasing what the task captured may destroy the WorkerPool. */
+                fn = nullptr;
+                lock.lock();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex run_mtx;
+    std::mutex mtx;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    const std::function<void(size_t)> *task = nullptr;
+    size_t ntasks = 0;
+    std::atomic<size_t> next{0};
+    size_t active = 0;
+    uint64_t generation = 0;
+    bool stop = false;
+    std::exception_ptr error;
+    std::deque<std::function<void()>> queue;
+
+    static thread_local const Impl *current;
+};
+
+thread_local const WorkerPool::Impl *WorkerPool::Impl::current = nullptr;
+
+WorkerPool::WorkerPool(size_t threads) : impl(std::make_shared<Impl>())
+{
+    Impl::start(impl, threads);
+}
+
+WorkerPool::~WorkerPool()
+{
+    impl->shutdown();
+}
+
+void
+WorkerPool::run(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0)
+        return;
+    impl->run(count, task);
+}
+
+void
+WorkerPool::post(std::function<void()> task)
+{
+    if (!impl->has_threads()) {
+        try {
+            task();
+        } catch (...) {
+        }
+        return;
+    }
+    impl->post(std::move(task));
+}
+
+ParallelExecutor
+WorkerPool::executor(size_t threads)
+{
+    std::shared_ptr<WorkerPool> pool = std::make_shared<WorkerPool>(threads);
+    return [pool](size_t count, const std::function<void(size_t)>& task) { pool->run(count, task); };
+}
+
+TaskExecutor
+WorkerPool::task_executor(size_t threads)
+{
+    std::shared_ptr<WorkerPool> pool = std::make_shared<WorkerPool>(threads);
+    return [pool](std::function<void()> task) { pool->post(std::move(task)); };
+}
+
+}
+}
+}
+}
@@ -0,0 +1,168 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+#include <assert.h>
+
+#include <org/eclipse/cyclonedds/core/cdr/cdr_stream.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DDSCXX_BYTE_SWAP_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define DDSCXX_BYTE_SWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace core {
+namespace cdr {
+
+namespace {
+
+/* swaps the bytes of as many whole vectors as fit in bytes, returns the number of bytes swapped */
+typedef size_t (*byte_swap_kernel)(unsigned char *data, size_t bytes, size_t size);
+
+#if defined(DDSCXX_BYTE_SWAP_X86)
+
+/* shuffle masks reversing the order of the bytes in each entity of size 2, 4 and 8,
+   the avx2 shuffle works on 128 bit lanes, so the masks repeat every 16 bytes */
+alignas(32) const unsigned char shuffle_masks[3][32] = {
+  {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+   1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+  {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+   3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+  {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+   7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}
+};
+
+const unsigned char *shuffle_mask(size_t size)
+{
+  return shuffle_masks[size == 2 ? 0 : (size == 4 ? 1 : 2)];
+}
+
+__attribute__((target("ssse3")))
+size_t byte_swap_ssse3(unsigned char *data, size_t bytes, size_t size)
+{
+  const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_mask(size)));
+  size_t done = 0;
+  for (; bytes - done >= 16; done += 16) {
+    __m128i *p = reinterpret_cast<__m128i*>(data + done);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+  return done;
+}
+
+__attribute__((target("avx2")))
+size_t byte_swap_avx2(unsigned char *data, size_t bytes, size_t size)
+{
+  const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle_mask(size)));
+  size_t done = 0;
+  for (; bytes - done >= 32; done += 32) {
+    __m256i *p = reinterpret_cast<__m256i*>(data + done);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+  }
+  if (bytes - done >= 16) {
+    __m128i *p = reinterpret_cast<__m128i*>(data + done);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), _mm256_castsi256_si128(mask)));
+    done += 16;
+  }
+  return done;
+}
+
+byte_swap_kernel select_kernel()
+{
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return byte_swap_avx2;
+  else if (__builtin_cpu_supports("ssse3"))
+    return byte_swap_ssse3;
+  else
+    return nullptr;
+}
+
+#elif defined(DDSCXX_BYTE_SWAP_NEON)
+
+size_t byte_swap_neon(unsigned char *data, size_t bytes, size_t size)
+{
+  size_t done = 0;
+  for (; bytes - done >= 16; done += 16) {
+    uint8x16_t v = vld1q_u8(data + done);
+    switch (size) {
+      case 2:
+        v = vrev16q_u8(v);
+        break;
+      case 4:
+        v = vrev32q_u8(v);
+        break;
+      default:
+        v = vrev64q_u8(v);
+    }
+    vst1q_u8(data + done, v);
+  }
+  return done;
+}
+
+byte_swap_kernel select_kernel()
+{
+  return byte_swap_neon;
+}
+
+#else
+
+byte_swap_kernel select_kernel()
+{
+  return nullptr;
+}
+
+#endif
+
+template<typename T>
+void byte_swap_scalar(unsigned char *data, size_t N)
+{
+  T *ptr = reinterpret_cast<T*>(data);
+  for (size_t i = 0; i < N; i++, ptr++)
+    byte_swap(ptr);
+}
+
+}
+
+void byte_swap_n(void* toswap, size_t size, size_t N) noexcept
+{
+  assert(size == 2 || size == 4 || size == 8);
+
+  static const byte_swap_kernel kernel = select_kernel();
+
+  auto data = static_cast<unsigned char*>(toswap);
+  if (kernel) {
+    size_t done = kernel(data, size*N, size);
+    data += done;
+    N -= done/size;
+  }
+
+  switch (size) {
+    case 2:
+      byte_swap_scalar<uint16_t>(data, N);
+      break;
+    case 4:
+      byte_swap_scalar<uint32_t>(data, N);
+      break;
+    case 8:
+      byte_swap_scalar<uint64_t>(data, N);
+      break;
+  }
+}
+
+}
+}
+}
+}
+}
@@ -120,7 +120,7 @@ bool cdr_stream::check_struct_completeness(const entity_properties_t &props, con
   const entity_properties_t *ptr = props.first_member;
   while (ptr) {
     if ((ptr->must_understand || ptr->is_key) &&  //if this entity is a must_understand or key member
-        member_ids.end() == member_ids.find(ptr->m_id) && //and it was not succesfully deserialized
+        !member_ids.count(ptr->m_id) && //and it was not succesfully deserialized
         status(must_understand_fail)) //and we cannot ignore missing must_understand fields
       return false;
     ptr = cdr_stream::next_entity(ptr);
@@ -131,7 +131,8 @@ bool cdr_stream::check_struct_completeness(const entity_properties_t &props, con
 
 bool cdr_stream::finish_member(const entity_properties_t &props, member_id_set &member_ids, bool is_set)
 {
-  if (is_set)
+  //the member ids are only checked for completeness when reading
+  if (is_set && m_mode == stream_mode::read)
     member_ids.insert(props.m_id);
   return true;
 }
@@ -163,6 +164,15 @@ bool cdr_stream::is_key() const
   return m_key == key_mode::sorted || m_key == key_mode::unsorted;
 }
 
+bool cdr_stream::direct_copy_possible(size_t al) const
+{
+  if (!al || is_key() || m_swap || position() == SIZE_MAX)
+    return false;
+
+  al = std::min(al, m_max_alignment);
+  return (position() - m_alignment_offset) % al == 0;
+}
+
 void cdr_stream::push_member_start()
 {
   m_e_sz.push(0);
@@ -98,6 +98,19 @@ static void link_keys_sorted(entity_properties_t *prop)
   }
 }
 
+static void build_member_index(entity_properties_t &prop)
+{
+  prop.member_index.clear();
+  if (prop.e_ext != extensibility::ext_mutable)
+    return;
+
+  for (auto ptr = prop.first_member; ptr; ptr = ptr->next_on_level)
+    prop.member_index.push_back(ptr);
+
+  std::sort(prop.member_index.begin(), prop.member_index.end(),
+    [](const entity_properties_t *lhs, const entity_properties_t *rhs) { return lhs->m_id < rhs->m_id; });
+}
+
 void entity_properties_t::finish(propvec &props, const key_endpoint &keys)
 {
   assert(props.size());
@@ -144,6 +157,10 @@ void entity_properties_t::finish(propvec &props, const key_endpoint &keys)
 
   //add sorted key linkage
   link_keys_sorted(&props[0]);
+
+  //add member id lookup for mutable entities
+  for (auto &p:props)
+    build_member_index(p);
 }
 
 const entity_properties_t *entity_properties_t::first_entity(key_mode key) const
@@ -200,6 +217,26 @@ const entity_properties_t* entity_properties_t::previous_entity(key_mode key) co
   }
 }
 
+const entity_properties_t* entity_properties_t::find_member(uint32_t id, key_mode key) const
+{
+  const entity_properties_t *ptr = nullptr;
+  if (member_index.size()) {
+    auto it = std::lower_bound(member_index.begin(), member_index.end(), id,
+      [](const entity_properties_t *lhs, uint32_t rhs) { return lhs->m_id < rhs; });
+    if (it != member_index.end() && (*it)->m_id == id)
+      ptr = *it;
+  } else {
+    ptr = first_member;
+    while (ptr && ptr->m_id != id)
+      ptr = ptr->next_on_level;
+  }
+
+  if (ptr && key != key_mode::not_key && !ptr->is_key)
+    return nullptr;
+
+  return ptr;
+}
+
 void entity_properties_t::print() const
 {
   std::cout <<  std::string( 2*depth, ' ' ) << "id: " << m_id << std::endl;
@@ -260,6 +297,7 @@ void entity_properties_t::append_struct_contents(propvec &appendto, const propve
     appendto[i].next_sorted_key     = nullptr;
     appendto[i].prev_unsorted_key   = nullptr;
     appendto[i].prev_sorted_key     = nullptr;
+    appendto[i].member_index.clear();
   }
 }
 
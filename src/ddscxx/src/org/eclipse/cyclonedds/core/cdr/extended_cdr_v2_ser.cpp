@@ -134,17 +134,8 @@ const entity_properties_t* xcdr_v2_stream::next_entity(const entity_properties_t
         continue;
       }
 
-      //search forward
-      auto p = prop;
-      while (p && p->m_id != temp.m_id)
-        p = cdr_stream::next_entity(p);
-
-      //search backward
-      if (!p) {
-        p = prop;
-        while (p && p->m_id != temp.m_id)
-          p = cdr_stream::previous_entity(p);
-      }
+      //look up the member by its id
+      auto p = prop->parent->find_member(temp.m_id, m_key);
 
       if (!p) {  //could not find this entry in the list of parameters
         if (temp.must_understand &&
@@ -193,10 +184,8 @@ const entity_properties_t* xcdr_v2_stream::first_entity(const entity_properties_
         continue;
       }
 
-      //search forward
-      auto p = prop;
-      while (p && p->m_id != temp.m_id)
-        p = cdr_stream::next_entity(p);
+      //look up the member by its id
+      auto p = props->find_member(temp.m_id, m_key);
 
       if (!p) {  //could not find this entry in the list of parameters
         if (temp.must_understand &&
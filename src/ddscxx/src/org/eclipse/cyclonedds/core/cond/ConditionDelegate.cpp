@@ -61,6 +61,33 @@ org::eclipse::cyclonedds::core::cond::ConditionDelegate::detach_from_waitset(
     }
 }
 
+void
+org::eclipse::cyclonedds::core::cond::ConditionDelegate::replace_ddsc_entity(
+    const dds_entity_t entity_handle)
+{
+    const dds_entity_t old_handle = this->get_ddsc_entity();
+
+    // waitsets attaching the condition from now on attach the new entity
+    this->delete_from_entity_map();
+    this->set_ddsc_entity(entity_handle);
+    this->add_to_entity_map(this->get_weak_ref());
+
+    std::vector<WaitSetDelegate *> waitset_list_tmp;
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLockForCopy(this->waitSetListUpdateMutex);
+    waitset_list_tmp.assign(this->waitSetList.begin(), this->waitSetList.end());
+    scopedLockForCopy.unlock();
+
+    for (auto waitset : waitset_list_tmp) {
+        org::eclipse::cyclonedds::core::ScopedObjectLock scopedWaisetLock(*waitset);
+        {
+            org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->waitSetListUpdateMutex);
+            if (this->waitSetList.count(waitset)) {
+                waitset->replace_condition_locked(this, old_handle, entity_handle);
+            }
+        }
+    }
+}
+
 void
 org::eclipse::cyclonedds::core::cond::ConditionDelegate::detach_and_close(
     const dds_entity_t entity_handle)
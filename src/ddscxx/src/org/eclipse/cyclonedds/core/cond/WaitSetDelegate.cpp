@@ -20,6 +20,54 @@
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/core/Mutex.hpp>
 
+#include <algorithm>
+
+namespace
+{
+
+/* Lends the attach buffer of a waitset to the waiting thread, a concurrent wait
+ * on the same waitset uses a buffer of its own. */
+class AttachBuffer
+{
+public:
+    AttachBuffer(std::vector<dds_attach_t>& shared, std::atomic<bool>& busy, size_t size) :
+        busy_(busy),
+        owner_(!busy.exchange(true, std::memory_order_acquire)),
+        buf_(owner_ ? shared : local_)
+    {
+        try {
+            if (buf_.size() < size)
+                buf_.resize(size);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    ~AttachBuffer()
+    {
+        release();
+    }
+
+    dds_attach_t *data()
+    {
+        return buf_.data();
+    }
+
+private:
+    void release()
+    {
+        if (owner_)
+            busy_.store(false, std::memory_order_release);
+    }
+
+    std::atomic<bool>& busy_;
+    const bool owner_;
+    std::vector<dds_attach_t> local_;
+    std::vector<dds_attach_t>& buf_;
+};
+
+}
 
 org::eclipse::cyclonedds::core::cond::WaitSetDelegate::WaitSetDelegate()
 {
@@ -73,33 +121,61 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::wait(
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     const size_t sz = conditions_.size();
     scopedLock.unlock();
-    dds_attach_t * attach = (sz == 0) ? nullptr : new dds_attach_t[sz];
+    AttachBuffer attach(this->attach_, this->attach_busy_, sz);
 
-    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(), attach, sz, c_timeout);
+    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(), attach.data(), sz, c_timeout);
 
     if (n_triggered == 0) {
-        delete[] attach;
         ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR, "dds::core::cond::WaitSet::wait() timed out.");
     } else if (n_triggered > 0) {
-        const size_t nt = size_t(n_triggered);
-        triggered.reserve(nt);
+        const size_t nt = std::min(size_t(n_triggered), sz);
+        /* Reserving more room on every call would defeat geometric growth. */
+        if (triggered.empty())
+            triggered.reserve(nt);
 
-        for (size_t i = 0; i < nt && i < sz; i++) {
+        for (size_t i = 0; i < nt; i++) {
             org::eclipse::cyclonedds::core::cond::ConditionDelegate *cd =
-                reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(attach[i]);
+                reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(attach.data()[i]);
             assert(cd);
             cd->dispatch();
             triggered.push_back(cd->wrapper());
         }
-        delete[] attach;
     } else {
-        delete[] attach;
         ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n_triggered, "dds_waitset_wait failed");
     }
 
     return triggered;
 }
 
+size_t
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::wait(
+    org::eclipse::cyclonedds::core::cond::ConditionDelegate **triggered,
+    size_t max_triggered,
+    const dds::core::Duration& timeout)
+{
+    dds_duration_t c_timeout = org::eclipse::cyclonedds::core::convertDuration(timeout);
+    this->check();
+    AttachBuffer attach(this->attach_, this->attach_busy_, max_triggered);
+
+    dds_return_t n_triggered = dds_waitset_wait(this->get_ddsc_entity(), attach.data(), max_triggered, c_timeout);
+
+    if (n_triggered == 0) {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR, "dds::core::cond::WaitSet::wait() timed out.");
+    }
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(n_triggered, "dds_waitset_wait failed");
+
+    const size_t nt = std::min(size_t(n_triggered), max_triggered);
+    for (size_t i = 0; i < nt; i++) {
+        org::eclipse::cyclonedds::core::cond::ConditionDelegate *cd =
+            reinterpret_cast <org::eclipse::cyclonedds::core::cond::ConditionDelegate *>(attach.data()[i]);
+        assert(cd);
+        cd->dispatch();
+        triggered[i] = cd;
+    }
+
+    return nt;
+}
+
 void
 org::eclipse::cyclonedds::core::cond::WaitSetDelegate::dispatch(
     const dds::core::Duration& timeout)
@@ -181,6 +257,26 @@ org::eclipse::cyclonedds::core::cond::WaitSetDelegate::remove_condition_locked(
   }
 }
 
+// this will be called when holding the lock
+void
+org::eclipse::cyclonedds::core::cond::WaitSetDelegate::replace_condition_locked(
+    org::eclipse::cyclonedds::core::cond::ConditionDelegate *cond,
+    const dds_entity_t old_handle,
+    const dds_entity_t new_handle)
+{
+  dds_return_t ret;
+  if (conditions_.find(cond) != conditions_.end()) {
+    // the new entity is attached with the same attach value, so the condition
+    // remains triggered from the waitset; it may already be attached when the
+    // condition was attached after its entity was replaced
+    ret = dds_waitset_attach(this->ddsc_entity, new_handle,
+                             reinterpret_cast<dds_attach_t>(cond));
+    if (ret != DDS_RETCODE_PRECONDITION_NOT_MET)
+      ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Failed to attach condition");
+    (void) dds_waitset_detach(this->ddsc_entity, old_handle);
+  }
+}
+
 org::eclipse::cyclonedds::core::cond::WaitSetDelegate::ConditionSeq&
 org::eclipse::cyclonedds::core::cond::WaitSetDelegate::conditions(
     ConditionSeq& conds) const
@@ -19,6 +19,7 @@
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
 #include <dds/dds.h>
+#include <vector>
 
 #include "dds/ddsi/ddsi_protocol.h"
 #include "dds/features.hpp"
@@ -90,7 +91,6 @@ AnyDataWriterDelegate::write_cdr(
     const dds::core::Time& timestamp,
     uint32_t statusinfo)
 {
-    dds_return_t ret;
     struct ddsi_serdata *ser_data;
     ddsrt_iovec_t blob_holders[2];
 
@@ -111,19 +111,44 @@ AnyDataWriterDelegate::write_cdr(
         blob_holders,
         data->payload().size() + 4);
 
-    ser_data->statusinfo = statusinfo;
+    this->write_serdata(writer, ser_data, timestamp, statusinfo);
+}
+
+void
+AnyDataWriterDelegate::write_serdata(
+    dds_entity_t writer,
+    struct ddsi_serdata *data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo)
+{
+    dds_return_t ret;
 
+    if (data == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Invalid serialized sample.");
+
+    data->statusinfo = statusinfo;
+
+    /* The serdata is consumed by ddsc, also when the write fails. */
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
-        ser_data->timestamp.v = ddsc_time;
-        ret = dds_forwardcdr(writer, ser_data);
+        data->timestamp.v = ddsc_time;
+        ret = dds_forwardcdr(writer, data);
     } else {
-        ret = dds_writecdr(writer, ser_data);
+        ret = dds_writecdr(writer, data);
     }
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write_cdr failed.");
 }
 
+void
+AnyDataWriterDelegate::write_cdr(
+    dds_entity_t writer,
+    struct ddsi_serdata *data,
+    const dds::core::Time& timestamp)
+{
+    this->write_serdata(writer, data, timestamp, 0);
+}
+
 void
 AnyDataWriterDelegate::write_cdr(
     dds_entity_t writer,
@@ -134,6 +159,44 @@ AnyDataWriterDelegate::write_cdr(
     this->write_cdr(writer, data, handle, timestamp, 0);
 }
 
+struct ddsi_serdata *
+AnyDataWriterDelegate::serialize_sample(
+    const struct ddsi_sertype *type,
+    const void *data,
+    const dds::core::Time& timestamp)
+{
+    struct ddsi_serdata *ser_data = ddsi_serdata_from_sample(type, SDK_DATA, data);
+    if (ser_data == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not serialize sample.");
+
+    /* The serdata is shared by all writes of it, so fill in everything the
+     * writes need now: it must not be modified once it has been written. */
+    ser_data->statusinfo = 0;
+    if (timestamp != dds::core::Time::invalid())
+        ser_data->timestamp.v = org::eclipse::cyclonedds::core::convertTime(timestamp);
+    else
+        ser_data->timestamp.v = dds_time();
+
+    return ser_data;
+}
+
+void
+AnyDataWriterDelegate::release_serdata(
+    struct ddsi_serdata *data)
+{
+    ddsi_serdata_unref(data);
+}
+
+void
+AnyDataWriterDelegate::write_serialized(
+    dds_entity_t writer,
+    struct ddsi_serdata *data)
+{
+    /* The reference is consumed by ddsc, also when the write fails. */
+    dds_return_t ret = dds_forwardcdr(writer, ddsi_serdata_ref(data));
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write failed.");
+}
+
 void
 AnyDataWriterDelegate::dispose_cdr(
     dds_entity_t writer,
@@ -228,6 +291,78 @@ AnyDataWriterDelegate::writedispose(
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "writedispose failed.");
 }
 
+void
+AnyDataWriterDelegate::write_batch(
+    dds_entity_t writer,
+    SerializedBatch& batch,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo)
+{
+    dds_return_t ret = DDS_RETCODE_OK;
+    const bool has_timestamp = (timestamp != dds::core::Time::invalid());
+    const dds_time_t ddsc_time = has_timestamp ? org::eclipse::cyclonedds::core::convertTime(timestamp) : 0;
+    const size_t count = batch.samples_.size();
+
+    /* All samples were serialized before any of them is handed to ddsc, so a
+     * sample that cannot be serialized does not leave a partially written batch.
+     * The serdata is consumed by ddsc, also when the write fails. */
+    while (batch.written_ < count && ret == DDS_RETCODE_OK) {
+        struct ddsi_serdata *ser_data = batch.samples_[batch.written_++];
+        ser_data->statusinfo = statusinfo;
+        if (has_timestamp) {
+            ser_data->timestamp.v = ddsc_time;
+            ret = dds_forwardcdr(writer, ser_data);
+        } else {
+            ret = dds_writecdr(writer, ser_data);
+        }
+    }
+
+    if (ret != DDS_RETCODE_OK) {
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write failed after %lu of %lu samples were written.",
+                                           static_cast<unsigned long>(batch.written_ - 1),
+                                           static_cast<unsigned long>(count));
+    }
+}
+
+void
+AnyDataWriterDelegate::write_batch(
+    dds_entity_t writer,
+    SerializedBatch& batch,
+    const dds::core::Time& timestamp)
+{
+    this->write_batch(writer, batch, timestamp, 0);
+}
+
+void
+AnyDataWriterDelegate::writedispose_batch(
+    dds_entity_t writer,
+    SerializedBatch& batch,
+    const dds::core::Time& timestamp)
+{
+    this->write_batch(writer, batch, timestamp, DDSI_STATUSINFO_DISPOSE);
+}
+
+AnyDataWriterDelegate::SerializedBatch::~SerializedBatch()
+{
+    for (size_t i = written_; i < samples_.size(); i++)
+        ddsi_serdata_unref(samples_[i]);
+}
+
+void
+AnyDataWriterDelegate::SerializedBatch::append(
+    const struct ddsi_sertype *type,
+    const void *data)
+{
+    /* Make room first, so that the serdata cannot be lost. */
+    samples_.push_back(nullptr);
+    struct ddsi_serdata *ser_data = ddsi_serdata_from_sample(type, SDK_DATA, data);
+    if (ser_data == nullptr) {
+        samples_.pop_back();
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not serialize sample of batch.");
+    }
+    samples_.back() = ser_data;
+}
+
 dds_instance_handle_t
 AnyDataWriterDelegate::register_instance(
     dds_entity_t writer,
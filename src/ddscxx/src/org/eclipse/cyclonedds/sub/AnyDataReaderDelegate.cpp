@@ -25,8 +25,14 @@
 #include "dds/dds.h"
 #include "dds/ddsc/dds_internal_api.h"
 
+#include <algorithm>
+
 #define NORMALIZE_LENGTH(maxs) maxs == static_cast<uint32_t>(dds::core::LENGTH_UNLIMITED) ? static_cast<uint32_t>(INT32_MAX) : maxs
 
+/* Upper bound on the number of samples reserved in a loan before collecting, larger
+ * reads grow the container by moving the already collected samples. */
+#define MAX_RESERVED_SAMPLES 1024u
+
 dds::sub::SampleInfo
 dds::sub::detail::SamplesHolder::sample_info_from_c(const dds_sample_info_t *si)
 {
@@ -54,7 +60,8 @@ struct ReaderCopyInfo {
 AnyDataReaderDelegate::AnyDataReaderDelegate(
         const dds::sub::qos::DataReaderQos& qos,
         const dds::topic::TopicDescription& td)
-  : qos_(qos), td_(td), sample_(0)
+  : reserve_limit_(reserve_limit(qos)), data_available_pending_(0),
+    instances_mask_(0), instances_valid_(false), qos_(qos), td_(td), sample_(0)
 {
 }
 
@@ -89,6 +96,7 @@ AnyDataReaderDelegate::qos(const dds::sub::qos::DataReaderQos& qos)
     dds_delete_qos(ddsc_qos);
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not set reader qos.");
     this->qos_ = qos;
+    this->reserve_limit_.store(reserve_limit(qos), std::memory_order_relaxed);
 }
 
 void
@@ -145,6 +153,23 @@ AnyDataReaderDelegate::collector_callback_fn (
 }
 
 
+uint32_t
+AnyDataReaderDelegate::reserve_limit(const dds::sub::qos::DataReaderQos& qos)
+{
+    int32_t limit = qos.policy<dds::core::policy::ResourceLimits>().max_samples();
+    if (limit != dds::core::LENGTH_UNLIMITED && static_cast<uint32_t>(limit) < MAX_RESERVED_SAMPLES)
+        return static_cast<uint32_t>(limit);
+    return MAX_RESERVED_SAMPLES;
+}
+
+uint32_t
+AnyDataReaderDelegate::reserve_length(uint32_t requested_max_samples) const
+{
+    uint32_t length = NORMALIZE_LENGTH(requested_max_samples);
+    uint32_t limit = reserve_limit_.load(std::memory_order_relaxed);
+    return length < limit ? length : limit;
+}
+
 bool
 AnyDataReaderDelegate::is_loan_supported(const dds_entity_t reader) const
 {
@@ -154,32 +179,99 @@ AnyDataReaderDelegate::is_loan_supported(const dds_entity_t reader) const
 }
 
 void
-AnyDataReaderDelegate::read_cdr(
+AnyDataReaderDelegate::parallel_deserialization(
+    const org::eclipse::cyclonedds::core::ParallelExecutor& executor,
+    uint32_t min_samples)
+{
+    std::shared_ptr<const ParallelDeserialization> parallel;
+    if (executor)
+        parallel = std::make_shared<const ParallelDeserialization>(ParallelDeserialization{executor, min_samples});
+    std::atomic_store(&this->parallel_, parallel);
+}
+
+void
+AnyDataReaderDelegate::listener_executor(
+    const org::eclipse::cyclonedds::core::TaskExecutor& executor)
+{
+    std::shared_ptr<const org::eclipse::cyclonedds::core::TaskExecutor> ex;
+    if (executor)
+        ex = std::make_shared<const org::eclipse::cyclonedds::core::TaskExecutor>(executor);
+    std::atomic_store(&this->listener_executor_, ex);
+}
+
+bool
+AnyDataReaderDelegate::offload_data_available()
+{
+    std::shared_ptr<const org::eclipse::cyclonedds::core::TaskExecutor> executor =
+        std::atomic_load(&this->listener_executor_);
+    if (!executor)
+        return false;
+
+    /* Only the first pending notification hands over a task, the others are
+     * picked up by it. */
+    if (this->data_available_pending_.fetch_add(1, std::memory_order_acq_rel) != 0)
+        return true;
+
+    org::eclipse::cyclonedds::core::ObjectDelegate::weak_ref_type weak = this->get_weak_ref();
+    AnyDataReaderDelegate *self = this;
+    try {
+        (*executor)([weak, self]() {
+            /* The reader is kept alive while the task runs, once it is closed
+             * the callback lock can no longer be obtained. */
+            org::eclipse::cyclonedds::core::ObjectDelegate::ref_type ref = weak.lock();
+            if (!ref)
+                return;
+            uint32_t n;
+            do {
+                n = self->data_available_pending_.load(std::memory_order_acquire);
+                if (self->obtain_callback_lock()) {
+                    try {
+                        self->notify_data_available();
+                    } catch (...) {
+                    }
+                    self->release_callback_lock();
+                }
+            } while (self->data_available_pending_.fetch_sub(n, std::memory_order_acq_rel) != n);
+        });
+    } catch (...) {
+        this->data_available_pending_.store(0, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+dds_return_t
+AnyDataReaderDelegate::collect(
     const dds_entity_t reader,
-    const dds::sub::status::DataState& mask,
+    bool take,
+    dds_instance_handle_t handle,
+    uint32_t ddsc_mask,
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
     /* The reader can also be a condition. */
-    ret = dds_read_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  DDS_HANDLE_NIL,
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    if (take) {
+        return dds_take_with_collector(reader,
+                                       NORMALIZE_LENGTH(requested_max_samples),
+                                       handle,
+                                       ddsc_mask,
+                                       collector_callback_fn,
+                                       &samples);
+    } else {
+        return dds_read_with_collector(reader,
+                                       NORMALIZE_LENGTH(requested_max_samples),
+                                       handle,
+                                       ddsc_mask,
+                                       collector_callback_fn,
+                                       &samples);
+    }
 }
 
 void
-AnyDataReaderDelegate::take_cdr(
+AnyDataReaderDelegate::collect_samples(
     const dds_entity_t reader,
+    bool take,
+    dds_instance_handle_t handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
@@ -187,67 +279,152 @@ AnyDataReaderDelegate::take_cdr(
     dds_return_t ret;
     uint32_t ddsc_mask = get_ddsc_state_mask(mask);
 
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    samples.reserve(reserve_length(requested_max_samples));
+    samples.deserialize_with(std::atomic_load(&this->parallel_));
 
-    /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  DDS_HANDLE_NIL,
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
+    ret = this->collect(reader, take, handle, ddsc_mask, samples, requested_max_samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    samples.complete();
+}
+
+dds_return_t
+AnyDataReaderDelegate::next_instance_callback_fn (
+    void *arg,
+    const dds_sample_info_t *si,
+    const struct ddsi_sertype *,
+    struct ddsi_serdata *)
+{
+    std::vector<dds_instance_handle_t> *handles = reinterpret_cast<std::vector<dds_instance_handle_t> *>(arg);
+    if (handles->empty() || handles->back() != si->instance_handle)
+        handles->push_back(si->instance_handle);
+    return DDS_RETCODE_OK;
+}
+
+dds_return_t
+AnyDataReaderDelegate::refresh_instances(
+    const dds_entity_t reader,
+    uint32_t ddsc_mask)
+{
+    /* Peeking leaves the sample states untouched and only visits the sample
+     * infos, the samples of an instance are visited one after the other. */
+    this->instances_.clear();
+    this->instances_valid_ = false;
+    dds_return_t ret = dds_peek_with_collector(reader,
+                                               static_cast<uint32_t>(INT32_MAX),
+                                               DDS_HANDLE_NIL,
+                                               ddsc_mask,
+                                               next_instance_callback_fn,
+                                               &this->instances_);
+    if (ret < 0)
+        return ret;
+    std::sort(this->instances_.begin(), this->instances_.end());
+    this->instances_.erase(std::unique(this->instances_.begin(), this->instances_.end()), this->instances_.end());
+    this->instances_mask_ = ddsc_mask;
+    this->instances_valid_ = true;
+    return ret;
+}
+
+dds_return_t
+AnyDataReaderDelegate::next_instance_handle(
+    const dds_entity_t reader,
+    dds_instance_handle_t handle,
+    uint32_t ddsc_mask,
+    dds_instance_handle_t& next)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(this->instances_mutex_);
+    dds_return_t ret = DDS_RETCODE_OK;
+    bool refreshed = false;
+
+    next = DDS_HANDLE_NIL;
+    if (handle == DDS_HANDLE_NIL || !this->instances_valid_ || this->instances_mask_ != ddsc_mask) {
+        if ((ret = this->refresh_instances(reader, ddsc_mask)) < 0)
+            return ret;
+        refreshed = true;
+    }
+
+    auto it = std::upper_bound(this->instances_.begin(), this->instances_.end(), handle);
+    if (it == this->instances_.end() && !refreshed) {
+        if ((ret = this->refresh_instances(reader, ddsc_mask)) < 0)
+            return ret;
+        it = std::upper_bound(this->instances_.begin(), this->instances_.end(), handle);
+    }
+    if (it != this->instances_.end())
+        next = *it;
+    return ret;
 }
 
 void
-AnyDataReaderDelegate::loaned_read(
+AnyDataReaderDelegate::collect_next_instance(
     const dds_entity_t reader,
+    bool take,
+    const dds::core::InstanceHandle& handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
     dds_return_t ret;
     uint32_t ddsc_mask = get_ddsc_state_mask(mask);
+    dds_instance_handle_t next = handle->handle();
 
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_read_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  DDS_HANDLE_NIL,
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
+    samples.reserve(reserve_length(requested_max_samples));
+    samples.deserialize_with(std::atomic_load(&this->parallel_));
+
+    /* Instances are ordered by their handles. The next instance can lose its
+     * matching samples, or disappear altogether, before they are collected:
+     * then move on to the instance after it. */
+    do {
+        ret = this->next_instance_handle(reader, next, ddsc_mask, next);
+        if (ret < 0 || next == DDS_HANDLE_NIL)
+            break;
+        ret = this->collect(reader, take, next, ddsc_mask, samples, requested_max_samples);
+    } while (ret == 0 || ret == DDS_RETCODE_PRECONDITION_NOT_MET);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    samples.complete();
 }
 
+void
+AnyDataReaderDelegate::read_cdr(
+    const dds_entity_t reader,
+    const dds::sub::status::DataState& mask,
+    dds::sub::detail::SamplesHolder& samples,
+    uint32_t requested_max_samples)
+{
+    this->collect_samples(reader, false, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
+}
 
 void
-AnyDataReaderDelegate::loaned_take(
+AnyDataReaderDelegate::take_cdr(
     const dds_entity_t reader,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
+    this->collect_samples(reader, true, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
+}
 
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
+void
+AnyDataReaderDelegate::loaned_read(
+    const dds_entity_t reader,
+    const dds::sub::status::DataState& mask,
+    dds::sub::detail::SamplesHolder& samples,
+    uint32_t requested_max_samples)
+{
+    this->collect_samples(reader, false, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
+}
 
-    /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  DDS_HANDLE_NIL,
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
 
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+void
+AnyDataReaderDelegate::loaned_take(
+    const dds_entity_t reader,
+    const dds::sub::status::DataState& mask,
+    dds::sub::detail::SamplesHolder& samples,
+    uint32_t requested_max_samples)
+{
+    this->collect_samples(reader, true, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
 }
 
 void
@@ -258,21 +435,7 @@ AnyDataReaderDelegate::loaned_read_instance(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_read_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  handle->handle(),
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, false, handle->handle(), mask, samples, requested_max_samples);
 }
 
 void
@@ -283,21 +446,7 @@ AnyDataReaderDelegate::loaned_take_instance(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader,
-                                  NORMALIZE_LENGTH(requested_max_samples),
-                                  handle->handle(),
-                                  ddsc_mask,
-                                  collector_callback_fn,
-                                  &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, true, handle->handle(), mask, samples, requested_max_samples);
 }
 
 void
@@ -306,15 +455,9 @@ AnyDataReaderDelegate::loaned_read_next_instance(
     const dds::core::InstanceHandle& handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
-    uint32_t max_samples)
+    uint32_t requested_max_samples)
 {
-    (void)reader;
-    (void)handle;
-    (void)mask;
-    (void)samples;
-    (void)max_samples;
-    /* Probably use dds_read_next(). Doesn't support conditions though... */
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Read next instance not currently supported");
+    this->collect_next_instance(reader, false, handle, mask, samples, requested_max_samples);
 }
 
 void
@@ -323,15 +466,9 @@ AnyDataReaderDelegate::loaned_take_next_instance(
     const dds::core::InstanceHandle& handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
-    uint32_t max_samples)
+    uint32_t requested_max_samples)
 {
-    (void)reader;
-    (void)handle;
-    (void)mask;
-    (void)samples;
-    (void)max_samples;
-    /* Probably use dds_take_next(). Doesn't support conditions though... */
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Take next instance not currently supported");
+    this->collect_next_instance(reader, true, handle, mask, samples, requested_max_samples);
 }
 
 void
@@ -341,16 +478,7 @@ AnyDataReaderDelegate::read(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_read_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), DDS_HANDLE_NIL, ddsc_mask, collector_callback_fn, &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, false, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
 }
 
 
@@ -361,16 +489,7 @@ AnyDataReaderDelegate::take(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), DDS_HANDLE_NIL, ddsc_mask, collector_callback_fn, &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, true, DDS_HANDLE_NIL, mask, samples, requested_max_samples);
 }
 
 void
@@ -381,16 +500,7 @@ AnyDataReaderDelegate::read_instance(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_read_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), handle->handle(), ddsc_mask, collector_callback_fn, &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, false, handle->handle(), mask, samples, requested_max_samples);
 }
 
 void
@@ -401,16 +511,7 @@ AnyDataReaderDelegate::take_instance(
     dds::sub::detail::SamplesHolder& samples,
     uint32_t requested_max_samples)
 {
-    dds_return_t ret;
-    uint32_t ddsc_mask = get_ddsc_state_mask(mask);
-
-    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
-    this->check();
-
-    /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), handle->handle(), ddsc_mask, collector_callback_fn, &samples);
-
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
+    this->collect_samples(reader, true, handle->handle(), mask, samples, requested_max_samples);
 }
 
 void
@@ -419,15 +520,9 @@ AnyDataReaderDelegate::read_next_instance(
     const dds::core::InstanceHandle& handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
-    uint32_t max_samples)
+    uint32_t requested_max_samples)
 {
-    (void)reader;
-    (void)handle;
-    (void)mask;
-    (void)samples;
-    (void)max_samples;
-    /* Probably use dds_read_next(). Doesn't support conditions though... */
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Read next instance not currently supported");
+    this->collect_next_instance(reader, false, handle, mask, samples, requested_max_samples);
 }
 
 void
@@ -436,15 +531,9 @@ AnyDataReaderDelegate::take_next_instance(
     const dds::core::InstanceHandle& handle,
     const dds::sub::status::DataState& mask,
     dds::sub::detail::SamplesHolder& samples,
-    uint32_t max_samples)
-{
-    (void)reader;
-    (void)handle;
-    (void)mask;
-    (void)samples;
-    (void)max_samples;
-    /* Probably use dds_take_next(). Doesn't support conditions though... */
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Take next instance not currently supported");
+    uint32_t requested_max_samples)
+{
+    this->collect_next_instance(reader, true, handle, mask, samples, requested_max_samples);
 }
 
 void
@@ -18,12 +18,89 @@
 
 #include <org/eclipse/cyclonedds/sub/QueryDelegate.hpp>
 #include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
+
+#include <atomic>
+
+namespace
+{
+
+using org::eclipse::cyclonedds::topic::FilterExpression;
+
+/* ddsc only passes the sample to the filter of a query condition, so every query condition
+ * gets a filter function of its own, which evaluates the expression in its slot. */
+const size_t max_query_filters = 256;
+const size_t no_query_filter = SIZE_MAX;
+
+std::shared_ptr<const FilterExpression> query_filters[max_query_filters];
+bool query_filters_used[max_query_filters];
+org::eclipse::cyclonedds::core::Mutex query_filters_mutex;
+
+template <size_t N>
+bool query_filter(const void* sample)
+{
+    std::shared_ptr<const FilterExpression> filter = std::atomic_load(&query_filters[N]);
+    return filter && filter->matches(sample);
+}
+
+template <size_t N>
+struct QueryFilterTable
+{
+    static void fill(dds_querycondition_filter_fn* table)
+    {
+        QueryFilterTable<N - 1>::fill(table);
+        table[N - 1] = &query_filter<N - 1>;
+    }
+};
+
+template <>
+struct QueryFilterTable<0>
+{
+    static void fill(dds_querycondition_filter_fn*)
+    {
+    }
+};
+
+dds_querycondition_filter_fn query_filter_function(size_t slot)
+{
+    static struct Functions {
+        Functions() { QueryFilterTable<max_query_filters>::fill(fn); }
+        dds_querycondition_filter_fn fn[max_query_filters];
+    } functions;
+    return functions.fn[slot];
+}
+
+size_t acquire_query_filter(const std::shared_ptr<const FilterExpression>& filter)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(query_filters_mutex);
+    for (size_t i = 0; i < max_query_filters; i++) {
+        if (!query_filters_used[i]) {
+            query_filters_used[i] = true;
+            std::atomic_store(&query_filters[i], filter);
+            return i;
+        }
+    }
+    ISOCPP_THROW_EXCEPTION(ISOCPP_OUT_OF_RESOURCES_ERROR,
+        "Too many queries in use, at most %u can be used at the same time",
+        static_cast<unsigned>(max_query_filters));
+    return no_query_filter;
+}
+
+void release_query_filter(size_t slot)
+{
+    org::eclipse::cyclonedds::core::ScopedMutexLock scopedLock(query_filters_mutex);
+    std::atomic_store(&query_filters[slot], std::shared_ptr<const FilterExpression>());
+    query_filters_used[slot] = false;
+}
+
+}
 
 org::eclipse::cyclonedds::sub::QueryDelegate::QueryDelegate(
     const dds::sub::AnyDataReader& dr,
     const dds::sub::status::DataState& state_filter) :
         reader_(dr), expression_("1=1"),
-        state_filter_(state_filter), modified_(true)
+        state_filter_(state_filter), modified_(true),
+        filter_slot_(no_query_filter), query_(0)
 {
     ISOCPP_BOOL_CHECK_AND_THROW((dr != dds::core::null),
                                 ISOCPP_NULL_REFERENCE_ERROR,
@@ -35,7 +112,8 @@ org::eclipse::cyclonedds::sub::QueryDelegate::QueryDelegate(
     const std::string& expression,
     const dds::sub::status::DataState& state_filter) :
         reader_(dr), expression_(expression),
-        state_filter_(state_filter), modified_(true)
+        state_filter_(state_filter), modified_(true),
+        filter_slot_(no_query_filter), query_(0)
 {
     ISOCPP_BOOL_CHECK_AND_THROW((dr != dds::core::null),
                                 ISOCPP_NULL_REFERENCE_ERROR,
@@ -48,7 +126,8 @@ org::eclipse::cyclonedds::sub::QueryDelegate::QueryDelegate(
     const std::vector<std::string>& params,
     const dds::sub::status::DataState& state_filter) :
          reader_(dr), expression_(expression),
-         params_(params), state_filter_(state_filter), modified_(true)
+         params_(params), state_filter_(state_filter), modified_(true),
+         filter_slot_(no_query_filter), query_(0)
 {
     ISOCPP_BOOL_CHECK_AND_THROW((dr != dds::core::null),
                                 ISOCPP_NULL_REFERENCE_ERROR,
@@ -105,6 +184,12 @@ org::eclipse::cyclonedds::sub::QueryDelegate::close()
 
     deinit();
 
+    if (this->query_ > 0) {
+        dds_delete(this->query_);
+        this->query_ = 0;
+    }
+    release_filter();
+
     DDScObjectDelegate::close();
 }
 
@@ -155,6 +240,7 @@ org::eclipse::cyclonedds::sub::QueryDelegate::add_parameter(
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     params_.push_back(param);
+    this->modified_ = true;
 }
 
 uint32_t
@@ -170,8 +256,11 @@ org::eclipse::cyclonedds::sub::QueryDelegate::parameters_length() const
 void
 org::eclipse::cyclonedds::sub::QueryDelegate::parameters(const std::vector<std::string>& params)
 {
-    /* TODO */
-    (void)params;
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    if (this->params_ != params) {
+        this->params_ = params;
+        this->modified_ = true;
+    }
 }
 
 std::vector<std::string>
@@ -189,6 +278,7 @@ org::eclipse::cyclonedds::sub::QueryDelegate::clear_parameters()
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     if (!this->params_.empty()) {
         this->params_.erase(this->params_.begin(), this->params_.end());
+        this->modified_ = true;
     }
 }
 
@@ -240,3 +330,67 @@ org::eclipse::cyclonedds::sub::QueryDelegate::modify_state_filter(
     this->state_filter(s);
     return true;
 }
+
+dds_entity_t
+org::eclipse::cyclonedds::sub::QueryDelegate::query_condition(
+    std::shared_ptr<const org::eclipse::cyclonedds::topic::FilterExpression>& filter)
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    /* ddsc evaluates the expression when samples arrive, so changes to the query
+     * need a new query condition, evaluating it on the samples already there. */
+    if (this->query_ <= 0 || this->modified_) {
+        size_t old_slot = this->filter_slot_;
+        dds_entity_t query = create_query_condition();
+        if (this->query_ > 0)
+            dds_delete(this->query_);
+        release_replaced_filter(old_slot);
+        this->query_ = query;
+        this->modified_ = false;
+    }
+
+    filter = this->filter_;
+    return this->query_;
+}
+
+dds_entity_t
+org::eclipse::cyclonedds::sub::QueryDelegate::create_query_condition()
+{
+    std::shared_ptr<org::eclipse::cyclonedds::topic::FilterExpression> filter =
+        this->reader_.delegate()->compile_query(this->expression_, this->params_);
+
+    dds_entity_t ddsc_dr = this->reader_.delegate()->get_ddsc_entity();
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_dr, "Could not get reader entity");
+
+    uint32_t ddsc_mask = this->reader_.delegate()->get_ddsc_state_mask(this->state_filter_);
+
+    size_t slot = acquire_query_filter(filter);
+    dds_entity_t ddsc_query_cond = dds_create_querycondition(ddsc_dr, ddsc_mask, query_filter_function(slot));
+    if (ddsc_query_cond < 0) {
+        release_query_filter(slot);
+        ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_query_cond, "Could not create query condition.");
+    }
+
+    this->filter_ = filter;
+    this->filter_slot_ = slot;
+
+    return ddsc_query_cond;
+}
+
+void
+org::eclipse::cyclonedds::sub::QueryDelegate::release_replaced_filter(
+    size_t filter_slot)
+{
+    if (filter_slot != no_query_filter)
+        release_query_filter(filter_slot);
+}
+
+void
+org::eclipse::cyclonedds::sub::QueryDelegate::release_filter()
+{
+    if (this->filter_slot_ != no_query_filter) {
+        release_query_filter(this->filter_slot_);
+        this->filter_slot_ = no_query_filter;
+    }
+    this->filter_.reset();
+}
@@ -16,9 +16,9 @@ org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::QueryConditionDeleg
     const std::string& expression,
     const dds::sub::status::DataState& data_state) :
         QueryDelegate(dr, expression, data_state),
-        ReadConditionDelegate(dr, data_state)
+        ReadConditionDelegate(dr)
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "QueryCondition not currently supported");
+    this->set_ddsc_entity(this->create_query_condition());
 }
 
 org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::QueryConditionDelegate(
@@ -27,9 +27,18 @@ org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::QueryConditionDeleg
     const std::vector<std::string>& params,
     const dds::sub::status::DataState& data_state) :
         QueryDelegate(dr, expression, params, data_state),
-        ReadConditionDelegate(dr, data_state)
+        ReadConditionDelegate(dr)
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "QueryCondition not currently supported");
+    this->set_ddsc_entity(this->create_query_condition());
+}
+
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::QueryConditionDelegate(
+    const dds::sub::AnyDataReader& dr,
+    const dds::sub::status::DataState& data_state) :
+        QueryDelegate(dr, data_state),
+        ReadConditionDelegate(dr)
+{
+    this->set_ddsc_entity(this->create_query_condition());
 }
 
 /* The close() operation of Condition will try to remove this Condition from
@@ -46,6 +55,16 @@ org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::QueryConditionDeleg
  */
 org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::~QueryConditionDelegate()
 {
+    /* The ddsc query condition is deleted before its filter is released. */
+    if (!this->closed) {
+        try {
+            QueryDelegate::deinit();
+            DDScObjectDelegate::close();
+        } catch (...) {
+            /* Empty: the exception throw should have already traced an error. */
+        }
+    }
+    this->release_filter();
 }
 
 void
@@ -54,3 +73,99 @@ org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::init(
 {
     ReadConditionDelegate::init(weak_ref);
 }
+
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::close()
+{
+    ReadConditionDelegate::close();
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->release_filter();
+}
+
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::expression(
+    const std::string& expr)
+{
+    this->check();
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    if (this->expression_ != expr) {
+        std::string old_expr(this->expression_);
+        this->expression_ = expr;
+        try {
+            this->recreate_query_condition();
+        } catch (...) {
+            this->expression_ = old_expr;
+            throw;
+        }
+    }
+}
+
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::parameters(
+    const std::vector<std::string>& params)
+{
+    this->check();
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    if (this->params_ == params)
+        return;
+    std::vector<std::string> old_params(params);
+    this->params_.swap(old_params);
+    try {
+        this->recreate_query_condition();
+    } catch (...) {
+        this->params_.swap(old_params);
+        throw;
+    }
+}
+
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::add_parameter(
+    const std::string& param)
+{
+    this->check();
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->params_.push_back(param);
+    if (this->params_.size() >= this->filter_->required_parameters()) {
+        try {
+            this->recreate_query_condition();
+        } catch (...) {
+            this->params_.pop_back();
+            throw;
+        }
+    }
+}
+
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::clear_parameters()
+{
+    this->check();
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->params_.clear();
+}
+
+/* The expression is evaluated by ddsc when samples arrive, so a modified query
+ * needs a new ddsc query condition, which evaluates it on the samples already
+ * in the reader as well. It replaces the old one in the waitsets this condition
+ * is attached to, this condition itself remains the same. */
+void
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::recreate_query_condition()
+{
+    size_t old_slot = this->filter_slot_;
+    dds_entity_t old_cond = this->get_ddsc_entity();
+    dds_entity_t cond = this->create_query_condition();
+
+    this->replace_ddsc_entity(cond);
+    if (old_cond > 0)
+        dds_delete(old_cond);
+    release_replaced_filter(old_slot);
+}
+
+dds_entity_t
+org::eclipse::cyclonedds::sub::cond::QueryConditionDelegate::query_condition(
+    std::shared_ptr<const org::eclipse::cyclonedds::topic::FilterExpression>& filter)
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+
+    filter = this->filter_;
+    return this->get_ddsc_entity();
+}
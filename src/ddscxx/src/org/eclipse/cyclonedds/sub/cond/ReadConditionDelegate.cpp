@@ -37,6 +37,12 @@ org::eclipse::cyclonedds::sub::cond::ReadConditionDelegate::ReadConditionDelegat
     this->set_ddsc_entity(ddsc_read_cond);
 }
 
+org::eclipse::cyclonedds::sub::cond::ReadConditionDelegate::ReadConditionDelegate(
+    const dds::sub::AnyDataReader& dr) :
+        QueryDelegate(dr)
+{
+}
+
 /* The close() operation of Condition will try to remove this Condition from
  * its WaitSets. However, since the WaitSets hold a reference to their Conditions,
  * the destructor can never be invoked for Conditions that are still attached
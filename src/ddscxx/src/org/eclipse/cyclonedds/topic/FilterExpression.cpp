@@ -0,0 +1,699 @@
+// Copyright(c) 2023 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/topic/FilterExpression.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+using org::eclipse::cyclonedds::core::cdr::filter_field;
+using org::eclipse::cyclonedds::core::cdr::filter_kind;
+using org::eclipse::cyclonedds::core::cdr::filter_value;
+
+namespace
+{
+
+const size_t max_parameters = 100;
+
+bool is_numeric(filter_kind kind)
+{
+    return kind == filter_kind::signed_int || kind == filter_kind::unsigned_int || kind == filter_kind::floating;
+}
+
+bool compatible(filter_kind a, filter_kind b)
+{
+    return (is_numeric(a) && is_numeric(b)) || (a == filter_kind::string && b == filter_kind::string);
+}
+
+bool iequals(const std::string& str, const char* keyword)
+{
+    size_t n = strlen(keyword);
+    if (str.size() != n)
+        return false;
+    for (size_t i = 0; i < n; i++) {
+        if (toupper(static_cast<unsigned char>(str[i])) != keyword[i])
+            return false;
+    }
+    return true;
+}
+
+/* Parses a number, as an integer if it is one and fits, as a floating point number otherwise. */
+bool parse_number(const std::string& text, filter_value& value)
+{
+    const char* str = text.c_str();
+    char* end;
+
+    if (text.empty())
+        return false;
+
+    errno = 0;
+    long long i = strtoll(str, &end, 10);
+    if (*end == '\0' && errno == 0) {
+        value.kind = filter_kind::signed_int;
+        value.i = static_cast<int64_t>(i);
+        return true;
+    }
+    if (text[0] != '-') {
+        errno = 0;
+        unsigned long long u = strtoull(str, &end, 10);
+        if (*end == '\0' && errno == 0) {
+            value.kind = filter_kind::unsigned_int;
+            value.u = static_cast<uint64_t>(u);
+            return true;
+        }
+    }
+    errno = 0;
+    double d = strtod(str, &end);
+    if (*end == '\0' && errno == 0) {
+        value.kind = filter_kind::floating;
+        value.d = d;
+        return true;
+    }
+    return false;
+}
+
+double as_double(const filter_value& v)
+{
+    switch (v.kind) {
+    case filter_kind::signed_int:
+        return static_cast<double>(v.i);
+    case filter_kind::unsigned_int:
+        return static_cast<double>(v.u);
+    default:
+        return v.d;
+    }
+}
+
+/* Compares two values, returns false if they cannot be compared. */
+bool compare(const filter_value& a, const filter_value& b, int& result)
+{
+    if (a.kind == filter_kind::string && b.kind == filter_kind::string) {
+        size_t n = a.len < b.len ? a.len : b.len;
+        int c = n ? memcmp(a.s, b.s, n) : 0;
+        if (c == 0)
+            c = a.len < b.len ? -1 : (a.len > b.len ? 1 : 0);
+        result = c < 0 ? -1 : (c > 0 ? 1 : 0);
+        return true;
+    }
+    if (!is_numeric(a.kind) || !is_numeric(b.kind))
+        return false;
+
+    if (a.kind == filter_kind::floating || b.kind == filter_kind::floating) {
+        double x = as_double(a), y = as_double(b);
+        if (x < y)
+            result = -1;
+        else if (x > y)
+            result = 1;
+        else if (x == y)
+            result = 0;
+        else
+            return false;
+    } else if (a.kind == filter_kind::signed_int && b.kind == filter_kind::signed_int) {
+        result = a.i < b.i ? -1 : (a.i > b.i ? 1 : 0);
+    } else if (a.kind == filter_kind::unsigned_int && b.kind == filter_kind::unsigned_int) {
+        result = a.u < b.u ? -1 : (a.u > b.u ? 1 : 0);
+    } else if (a.kind == filter_kind::signed_int) {
+        result = a.i < 0 || static_cast<uint64_t>(a.i) < b.u ? -1 : (static_cast<uint64_t>(a.i) > b.u ? 1 : 0);
+    } else {
+        result = b.i < 0 || a.u > static_cast<uint64_t>(b.i) ? 1 : (a.u < static_cast<uint64_t>(b.i) ? -1 : 0);
+    }
+    return true;
+}
+
+/* Matches a string with a LIKE pattern, in which '%' matches any number of characters and
+   '_' matches a single character. */
+bool like(const char* s, size_t n, const char* p, size_t m)
+{
+    size_t i = 0, j = 0, star = SIZE_MAX, mark = 0;
+    while (i < n) {
+        if (j < m && p[j] == '%') {
+            star = j++;
+            mark = i;
+        } else if (j < m && (p[j] == '_' || p[j] == s[i])) {
+            i++;
+            j++;
+        } else if (star != SIZE_MAX) {
+            j = star + 1;
+            i = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (j < m && p[j] == '%')
+        j++;
+    return j == m;
+}
+
+}
+
+class FilterExpression::Compiler
+{
+public:
+    Compiler(FilterExpression& filter, const std::string& expression, Resolver resolve) :
+        filter(filter), expression(expression), resolve(resolve), position(0)
+    {
+    }
+
+    void compile()
+    {
+        next();
+        parse_or();
+        if (token.type != TOK_END)
+            fail("unexpected token");
+    }
+
+private:
+    enum TokenType {
+        TOK_END, TOK_IDENTIFIER, TOK_INTEGER, TOK_FLOAT, TOK_STRING, TOK_PARAMETER, TOK_LPAREN, TOK_RPAREN,
+        TOK_EQ, TOK_NE, TOK_LT, TOK_LE, TOK_GT, TOK_GE, TOK_AND, TOK_OR, TOK_NOT, TOK_BETWEEN, TOK_LIKE, TOK_TRUE, TOK_FALSE
+    };
+
+    struct Token
+    {
+        TokenType type;
+        std::string text;
+        size_t position;
+    };
+
+    /* Operand as parsed, parameters are bound to a slot once the kind they are compared with is known. */
+    struct Parsed
+    {
+        Operand::Kind kind;
+        size_t index;
+        filter_kind type;
+    };
+
+    void fail(const char* what) const
+    {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR,
+            "Invalid filter expression '%s': %s at position %u",
+            expression.c_str(), what, static_cast<unsigned>(token.position));
+    }
+
+    void next()
+    {
+        const char* str = expression.c_str();
+        size_t n = expression.size();
+
+        while (position < n && isspace(static_cast<unsigned char>(str[position])))
+            position++;
+
+        token.position = position;
+        token.text.clear();
+        if (position == n) {
+            token.type = TOK_END;
+            return;
+        }
+
+        char c = str[position];
+        char d = position + 1 < n ? str[position + 1] : '\0';
+        if (c == '(') {
+            token.type = TOK_LPAREN;
+            position++;
+        } else if (c == ')') {
+            token.type = TOK_RPAREN;
+            position++;
+        } else if (c == '=') {
+            token.type = TOK_EQ;
+            position++;
+        } else if (c == '<') {
+            token.type = d == '=' ? TOK_LE : (d == '>' ? TOK_NE : TOK_LT);
+            position += token.type == TOK_LT ? 1 : 2;
+        } else if (c == '>') {
+            token.type = d == '=' ? TOK_GE : TOK_GT;
+            position += token.type == TOK_GT ? 1 : 2;
+        } else if (c == '!' && d == '=') {
+            token.type = TOK_NE;
+            position += 2;
+        } else if (c == '\'') {
+            /* quotes within strings are written as two quotes */
+            token.type = TOK_STRING;
+            for (position++; ; position++) {
+                if (position == n)
+                    fail("unterminated string");
+                if (str[position] == '\'') {
+                    if (position + 1 < n && str[position + 1] == '\'')
+                        position++;
+                    else
+                        break;
+                }
+                token.text += str[position];
+            }
+            position++;
+        } else if (c == '%' && isdigit(static_cast<unsigned char>(d))) {
+            token.type = TOK_PARAMETER;
+            for (position++; position < n && isdigit(static_cast<unsigned char>(str[position])); position++)
+                token.text += str[position];
+        } else if (isdigit(static_cast<unsigned char>(c)) || ((c == '-' || c == '+' || c == '.') && (isdigit(static_cast<unsigned char>(d)) || d == '.'))) {
+            token.type = TOK_INTEGER;
+            size_t start = position;
+            if (c == '-' || c == '+')
+                position++;
+            while (position < n && isdigit(static_cast<unsigned char>(str[position])))
+                position++;
+            if (position < n && str[position] == '.') {
+                token.type = TOK_FLOAT;
+                position++;
+                while (position < n && isdigit(static_cast<unsigned char>(str[position])))
+                    position++;
+            }
+            if (position < n && (str[position] == 'e' || str[position] == 'E')) {
+                token.type = TOK_FLOAT;
+                position++;
+                if (position < n && (str[position] == '-' || str[position] == '+'))
+                    position++;
+                while (position < n && isdigit(static_cast<unsigned char>(str[position])))
+                    position++;
+            }
+            token.text = expression.substr(start, position - start);
+        } else if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = position;
+            while (position < n && (isalnum(static_cast<unsigned char>(str[position])) || str[position] == '_' || str[position] == '.'))
+                position++;
+            token.text = expression.substr(start, position - start);
+            if (iequals(token.text, "AND"))
+                token.type = TOK_AND;
+            else if (iequals(token.text, "OR"))
+                token.type = TOK_OR;
+            else if (iequals(token.text, "NOT"))
+                token.type = TOK_NOT;
+            else if (iequals(token.text, "BETWEEN"))
+                token.type = TOK_BETWEEN;
+            else if (iequals(token.text, "LIKE"))
+                token.type = TOK_LIKE;
+            else if (iequals(token.text, "TRUE"))
+                token.type = TOK_TRUE;
+            else if (iequals(token.text, "FALSE"))
+                token.type = TOK_FALSE;
+            else
+                token.type = TOK_IDENTIFIER;
+        } else {
+            fail("unexpected character");
+        }
+    }
+
+    size_t add(Node::Op op, size_t lhs = 0, size_t rhs = 0)
+    {
+        Node node;
+        node.op = op;
+        node.lhs = lhs;
+        node.rhs = rhs;
+        node.x = node.y = node.z = Operand{Operand::CONSTANT, 0};
+        filter.nodes.push_back(node);
+        return filter.nodes.size() - 1;
+    }
+
+    size_t parse_or()
+    {
+        size_t lhs = parse_and();
+        while (token.type == TOK_OR) {
+            next();
+            size_t rhs = parse_and();
+            lhs = add(Node::OR, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    size_t parse_and()
+    {
+        size_t lhs = parse_not();
+        while (token.type == TOK_AND) {
+            next();
+            size_t rhs = parse_not();
+            lhs = add(Node::AND, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    size_t parse_not()
+    {
+        if (token.type == TOK_NOT) {
+            next();
+            return add(Node::NOT, parse_not());
+        } else if (token.type == TOK_LPAREN) {
+            next();
+            size_t node = parse_or();
+            if (token.type != TOK_RPAREN)
+                fail("expected ')'");
+            next();
+            return node;
+        }
+        return parse_predicate();
+    }
+
+    size_t parse_predicate()
+    {
+        Parsed lhs = parse_operand();
+        bool negate = false;
+
+        if (token.type == TOK_NOT) {
+            negate = true;
+            next();
+            if (token.type != TOK_BETWEEN && token.type != TOK_LIKE)
+                fail("expected BETWEEN or LIKE");
+        }
+
+        if (token.type == TOK_BETWEEN) {
+            if (lhs.kind != Operand::FIELD)
+                fail("expected a member before BETWEEN");
+            next();
+            Parsed lo = parse_operand();
+            if (token.type != TOK_AND)
+                fail("expected AND");
+            next();
+            Parsed hi = parse_operand();
+            size_t node = add(negate ? Node::NOT_BETWEEN : Node::BETWEEN);
+            filter.nodes[node].x = bind(lhs, lhs.type);
+            filter.nodes[node].y = bind(lo, lhs.type);
+            filter.nodes[node].z = bind(hi, lhs.type);
+            return node;
+        }
+
+        Node::Op op;
+        switch (token.type) {
+        case TOK_EQ: op = Node::EQ; break;
+        case TOK_NE: op = Node::NE; break;
+        case TOK_LT: op = Node::LT; break;
+        case TOK_LE: op = Node::LE; break;
+        case TOK_GT: op = Node::GT; break;
+        case TOK_GE: op = Node::GE; break;
+        case TOK_LIKE: op = Node::LIKE; break;
+        default: fail("expected a comparison"); return 0;
+        }
+        next();
+        Parsed rhs = parse_operand();
+
+        filter_kind type;
+        if (op == Node::LIKE) {
+            if (lhs.kind != Operand::FIELD || lhs.type != filter_kind::string)
+                fail("expected a string member before LIKE");
+            type = filter_kind::string;
+        } else if (lhs.kind == Operand::FIELD) {
+            type = lhs.type;
+        } else if (rhs.kind == Operand::FIELD) {
+            type = rhs.type;
+        } else if (lhs.kind == Operand::CONSTANT) {
+            /* comparisons of literals, like "1 = 1", are constant but valid */
+            type = lhs.type;
+        } else if (rhs.kind == Operand::CONSTANT) {
+            type = rhs.type;
+        } else {
+            fail("expected a member or literal in the comparison");
+            return 0;
+        }
+
+        size_t node = add(op);
+        filter.nodes[node].x = bind(lhs, type);
+        filter.nodes[node].y = bind(rhs, type);
+        return negate ? add(Node::NOT, node) : node;
+    }
+
+    Parsed parse_operand()
+    {
+        Parsed parsed;
+        Value value;
+
+        switch (token.type) {
+        case TOK_IDENTIFIER: {
+            parsed.kind = Operand::FIELD;
+            parsed.index = field(token.text);
+            parsed.type = filter.fields[parsed.index].kind;
+            next();
+            return parsed;
+        }
+        case TOK_PARAMETER: {
+            parsed.kind = Operand::PARAMETER;
+            parsed.index = static_cast<size_t>(strtoul(token.text.c_str(), NULL, 10));
+            parsed.type = filter_kind::none;
+            if (token.text.size() > 2 || parsed.index >= max_parameters)
+                fail("parameter number out of range");
+            next();
+            return parsed;
+        }
+        case TOK_INTEGER:
+        case TOK_FLOAT:
+            if (!parse_number(token.text, value.value))
+                fail("invalid number");
+            break;
+        case TOK_STRING:
+            value.value.kind = filter_kind::string;
+            value.text = token.text;
+            break;
+        case TOK_TRUE:
+        case TOK_FALSE:
+            value.value.kind = filter_kind::signed_int;
+            value.value.i = token.type == TOK_TRUE ? 1 : 0;
+            break;
+        default:
+            fail("expected a member, literal or parameter");
+        }
+        parsed.kind = Operand::CONSTANT;
+        parsed.index = filter.constants.size();
+        parsed.type = value.value.kind;
+        filter.constants.push_back(value);
+        next();
+        return parsed;
+    }
+
+    /* Returns the index of a member, members referenced more than once are resolved once. */
+    size_t field(const std::string& name)
+    {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == name)
+                return i;
+        }
+        filter_field f;
+        if (!resolve(name, f))
+            fail("unknown member or member of an unsupported type");
+        names.push_back(name);
+        filter.fields.push_back(f);
+        return filter.fields.size() - 1;
+    }
+
+    Operand bind(const Parsed& parsed, filter_kind type)
+    {
+        if (parsed.kind == Operand::PARAMETER) {
+            filter.slots.push_back(Slot{parsed.index, type});
+            return Operand{Operand::PARAMETER, filter.slots.size() - 1};
+        }
+        if (!compatible(parsed.type, type))
+            fail("comparison of a string with a number");
+        return Operand{parsed.kind, parsed.index};
+    }
+
+    FilterExpression& filter;
+    const std::string& expression;
+    Resolver resolve;
+    size_t position;
+    Token token;
+    std::vector<std::string> names;
+};
+
+FilterExpression::FilterExpression(const std::string& expression, const std::vector<std::string>& params,
+                                   Resolver resolve, Loader load, Storer store, size_t keys) :
+    load(load), store(store), keys(keys)
+{
+    Compiler(*this, expression, resolve).compile();
+    parameters(params);
+}
+
+void
+FilterExpression::parameters(const std::vector<std::string>& params)
+{
+    if (params.size() > max_parameters) {
+        ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR,
+            "Invalid number of filter parameters '%u', maximum is %u",
+            static_cast<unsigned>(params.size()), static_cast<unsigned>(max_parameters));
+    }
+
+    std::shared_ptr<Values> values = std::make_shared<Values>(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        const Slot& slot = slots[i];
+        Value& value = (*values)[i];
+        if (slot.param >= params.size()) {
+            ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR,
+                "Missing filter parameter %%%u", static_cast<unsigned>(slot.param));
+        }
+
+        const std::string& text = params[slot.param];
+        if (slot.kind == filter_kind::string) {
+            /* string parameters may be quoted, like string literals */
+            value.value.kind = filter_kind::string;
+            if (text.size() >= 2 && text.front() == '\'' && text.back() == '\'')
+                value.text = text.substr(1, text.size() - 2);
+            else
+                value.text = text;
+        } else if (iequals(text, "TRUE") || iequals(text, "FALSE")) {
+            value.value.kind = filter_kind::signed_int;
+            value.value.i = iequals(text, "TRUE") ? 1 : 0;
+        } else if (!parse_number(text, value.value)) {
+            ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR,
+                "Filter parameter %%%u '%s' is not a number", static_cast<unsigned>(slot.param), text.c_str());
+        }
+    }
+
+    std::atomic_store(&params_, std::shared_ptr<const Values>(values));
+}
+
+size_t
+FilterExpression::required_parameters() const
+{
+    size_t n = 0;
+    for (const Slot& slot : slots) {
+        if (slot.param >= n)
+            n = slot.param + 1;
+    }
+    return n;
+}
+
+bool
+FilterExpression::matches(const void* sample) const
+{
+    std::shared_ptr<const Values> params = std::atomic_load(&params_);
+    return evaluate(nodes.size() - 1, sample, *params);
+}
+
+bool
+FilterExpression::key(void* sample) const
+{
+    if (!store || keys == 0)
+        return false;
+
+    std::shared_ptr<const Values> params = std::atomic_load(&params_);
+    std::vector<bool> set(fields.size(), false);
+    bool ok = true;
+    key(nodes.size() - 1, sample, *params, set, ok);
+
+    size_t n = 0;
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (set[i])
+            n++;
+    }
+    return ok && n == keys;
+}
+
+bool
+FilterExpression::fixes_key() const
+{
+    return key(nullptr);
+}
+
+/* Stores the key members compared for equality in the conjunction at node, the values
+   of these members in all matching samples, or only marks them without a sample. */
+void
+FilterExpression::key(size_t node, void* sample, const Values& params, std::vector<bool>& set, bool& ok) const
+{
+    const Node& n = nodes[node];
+    if (n.op == Node::AND) {
+        key(n.lhs, sample, params, set, ok);
+        key(n.rhs, sample, params, set, ok);
+    } else if (n.op == Node::EQ) {
+        const Operand* member = n.x.kind == Operand::FIELD ? &n.x : &n.y;
+        const Operand* value = n.x.kind == Operand::FIELD ? &n.y : &n.x;
+        if (member->kind != Operand::FIELD || value->kind == Operand::FIELD || !fields[member->index].key)
+            return;
+        /* a value the member cannot hold matches no samples, leave it to the expression */
+        if (sample && !store(sample, fields[member->index], get(*value, sample, params)))
+            ok = false;
+        set[member->index] = true;
+    }
+}
+
+filter_value
+FilterExpression::get(const Operand& operand, const void* sample, const Values& params) const
+{
+    const Value* value;
+    switch (operand.kind) {
+    case Operand::FIELD:
+        return load(sample, fields[operand.index]);
+    case Operand::CONSTANT:
+        value = &constants[operand.index];
+        break;
+    default:
+        value = &params[operand.index];
+        break;
+    }
+
+    filter_value v = value->value;
+    if (v.kind == filter_kind::string) {
+        v.s = value->text.data();
+        v.len = value->text.size();
+    }
+    return v;
+}
+
+bool
+FilterExpression::evaluate(size_t node, const void* sample, const Values& params) const
+{
+    const Node& n = nodes[node];
+    int lo = 0, hi = 0, c = 0;
+
+    switch (n.op) {
+    case Node::AND:
+        return evaluate(n.lhs, sample, params) && evaluate(n.rhs, sample, params);
+    case Node::OR:
+        return evaluate(n.lhs, sample, params) || evaluate(n.rhs, sample, params);
+    case Node::NOT:
+        return !evaluate(n.lhs, sample, params);
+    case Node::LIKE: {
+        filter_value s = get(n.x, sample, params), p = get(n.y, sample, params);
+        return s.kind == filter_kind::string && p.kind == filter_kind::string && like(s.s, s.len, p.s, p.len);
+    }
+    case Node::BETWEEN:
+    case Node::NOT_BETWEEN: {
+        filter_value v = get(n.x, sample, params);
+        if (!compare(v, get(n.y, sample, params), lo) || !compare(v, get(n.z, sample, params), hi))
+            return false;
+        return (lo >= 0 && hi <= 0) == (n.op == Node::BETWEEN);
+    }
+    default:
+        break;
+    }
+
+    if (!compare(get(n.x, sample, params), get(n.y, sample, params), c))
+        return false;
+    switch (n.op) {
+    case Node::EQ:
+        return c == 0;
+    case Node::NE:
+        return c != 0;
+    case Node::LT:
+        return c < 0;
+    case Node::LE:
+        return c <= 0;
+    case Node::GT:
+        return c > 0;
+    default:
+        return c >= 0;
+    }
+}
+
+}
+}
+}
+}
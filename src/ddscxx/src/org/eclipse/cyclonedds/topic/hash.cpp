@@ -28,10 +28,15 @@ namespace org
         }
 
         bool complex_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out)
+        {
+          return complex_key(in.data(), in.size(), out);
+        }
+
+        bool complex_key(const unsigned char* in, size_t sz, ddsi_keyhash_t& out)
         {
           ddsrt_md5_state_t md5st;
           ddsrt_md5_init(&md5st);
-          ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(in.data()), static_cast<unsigned int>(in.size()));
+          ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(in), static_cast<unsigned int>(sz));
           ddsrt_md5_finish(&md5st, reinterpret_cast<ddsrt_md5_byte_t*>(out.value));
 
           return true;
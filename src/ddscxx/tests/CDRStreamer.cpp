@@ -91,6 +91,40 @@ TEST_F(CDRStreamer, cdr_boundary)
   ASSERT_EQ(BS, BS2);
 }
 
+/*verifying reads/writes of large arrays of primitives in non-native endianness*/
+
+template<typename T>
+void verify_swapped_array()
+{
+  const endianness swapped = native_endianness() == endianness::little_endian ? endianness::big_endian : endianness::little_endian;
+  std::vector<T> in, out(67);
+  for (size_t i = 0; i < out.size(); i++)
+    in.push_back(static_cast<T>(0x0102030405060708ull * (i + 1)));
+
+  std::vector<char> buffer(sizeof(T)*in.size(), 0x0);
+  xcdr_v1_stream str(swapped);
+  str.set_buffer(buffer.data(), buffer.size());
+  ASSERT_TRUE(write(str, in[0], in.size()));
+
+  for (size_t i = 0; i < in.size(); i++) {
+    for (size_t j = 0; j < sizeof(T); j++)
+      ASSERT_EQ(buffer[i*sizeof(T)+j], reinterpret_cast<const char*>(&in[i])[sizeof(T)-1-j]);
+  }
+
+  str.reset();
+  ASSERT_TRUE(read(str, out[0], out.size()));
+  ASSERT_EQ(in, out);
+}
+
+TEST_F(CDRStreamer, cdr_swapped_arrays)
+{
+  verify_swapped_array<uint16_t>();
+  verify_swapped_array<uint32_t>();
+  verify_swapped_array<uint64_t>();
+  /* entities of other sizes, such as a 16 byte long double, are swapped one by one */
+  verify_swapped_array<std::conditional<sizeof(long double) == 16, long double, uint64_t>::type>();
+}
+
 /*verifying reads/writes of a basic struct*/
 
 TEST_F(CDRStreamer, cdr_basic)
@@ -790,6 +824,48 @@ TEST_F(CDRStreamer, cdr_must_understand)
   VerifyRead(v2_missing, MU, xcdr_v2_stream, key_mode::not_key, false, true);
 }
 
+/*verifying completeness checks on structs with member ids too large to fit in the member id bitmask*/
+
+TEST_F(CDRStreamer, cdr_must_understand_high_id)
+{
+  must_understand_high_id_struct MU('a','b','c');
+
+  bytes v2 {
+      0x00, 0x00, 0x00, 0x21, /*dheader*/
+      0x40, 0x00, 0x00, 0x64, /*must_understand_high_id_struct.a.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.a.emheader.nextint*/
+      'a', /*must_understand_high_id_struct.a*/
+      0x00, 0x00, 0x00, /*padding bytes*/
+      0xC0, 0x00, 0x00, 0xC8, /*must_understand_high_id_struct.b.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.b.emheader.nextint*/
+      'b', /*must_understand_high_id_struct.b*/
+      0x00, 0x00, 0x00, /*padding bytes*/
+      0xC0, 0x00, 0x01, 0x2C, /*must_understand_high_id_struct.c.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.c.emheader.nextint*/
+      'c', /*must_understand_high_id_struct.c*/
+      };
+  bytes v2_key {
+      0x00, 0x00, 0x00, 0x09, /*dheader*/
+      0xC0, 0x00, 0x01, 0x2C, /*must_understand_high_id_struct.c.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.c.emheader.nextint*/
+      'c', /*must_understand_high_id_struct.c*/
+      };
+  readwrite_test(MU, MU, v2, v2_key, xcdr_v2_stream);
+
+  /*this cdr stream does not contain the field b so it must be rejected on read*/
+  bytes v2_missing {
+      0x00, 0x00, 0x00, 0x15, /*dheader*/
+      0x40, 0x00, 0x00, 0x64, /*must_understand_high_id_struct.a.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.a.emheader.nextint*/
+      'a', /*must_understand_high_id_struct.a*/
+      0x00, 0x00, 0x00, /*padding bytes*/
+      0xC0, 0x00, 0x01, 0x2C, /*must_understand_high_id_struct.c.emheader*/
+      0x00, 0x00, 0x00, 0x01, /*must_understand_high_id_struct.c.emheader.nextint*/
+      'c', /*must_understand_high_id_struct.c*/
+      };
+  VerifyRead(v2_missing, MU, xcdr_v2_stream, key_mode::not_key, false, true);
+}
+
 /*verifying correct insertion of d-headers after opening arrays and sequences of non-primitive types*/
 
 TEST_F(CDRStreamer, d_header_insertion)
@@ -842,6 +918,82 @@ TEST_F(CDRStreamer, d_header_insertion)
   readwrite_test(DS, DS, DS_v2, DS_v2_key, xcdr_v2_stream);
 }
 
+/*verifying reads/writes of sequences and arrays of structs which are copied directly*/
+
+/*only streams in native endianness copy directly, their output is compared to
+  the same members written one by one through the primitive streamers*/
+template<typename S>
+void verify_pod_native(const pod_struct& PS, bool dheaders)
+{
+  const size_t al = get_pod_layout_alignment<pod_point>();
+  ASSERT_NE(al, 0u);
+
+  bytes expected(64, 0x0);
+  S ref(native_endianness());
+  ref.set_buffer(expected.data(), expected.size());
+  ASSERT_TRUE(write(ref, PS.c()));
+  if (dheaders)
+    ASSERT_TRUE(write(ref, static_cast<uint32_t>(4 + 4 * PS.s().size())));
+  ASSERT_TRUE(write(ref, static_cast<uint32_t>(PS.s().size())));
+  ASSERT_TRUE(ref.direct_copy_possible(al));
+  for (const auto& p: PS.s()) {
+    ASSERT_TRUE(write(ref, p.x()));
+    ASSERT_TRUE(write(ref, p.y()));
+  }
+  if (dheaders)
+    ASSERT_TRUE(write(ref, static_cast<uint32_t>(4 * PS.a().size())));
+  ASSERT_TRUE(ref.direct_copy_possible(al));
+  for (const auto& p: PS.a()) {
+    ASSERT_TRUE(write(ref, p.x()));
+    ASSERT_TRUE(write(ref, p.y()));
+  }
+  expected.resize(ref.position());
+
+  bytes buffer;
+  S str(native_endianness());
+  ASSERT_TRUE(move(str, PS, key_mode::not_key));
+  buffer.resize(str.position());
+  str.set_buffer(buffer.data(), buffer.size());
+  ASSERT_TRUE(write(str, PS, key_mode::not_key));
+  ASSERT_EQ(buffer, expected);
+
+  pod_struct PS2;
+  str.reset();
+  ASSERT_TRUE(read(str, PS2, key_mode::not_key));
+  ASSERT_EQ(PS, PS2);
+}
+
+TEST_F(CDRStreamer, cdr_pod_struct)
+{
+  pod_struct PS('a', {pod_point(1, 2), pod_point(3, 4)}, {pod_point(5, 6), pod_point(7, 8)});
+
+  bytes PS_xcdr_v1_normal {
+      'a' /*pod_struct.c*/,
+      0x00, 0x00, 0x00 /*padding bytes (3)*/,
+      0x00, 0x00, 0x00, 0x02 /*pod_struct.s.length*/,
+      0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04 /*pod_struct.s.data*/,
+      0x00, 0x05, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08 /*pod_struct.a*/
+      };
+  bytes PS_xcdr_v2_normal {
+      'a' /*pod_struct.c*/,
+      0x00, 0x00, 0x00 /*padding bytes (3)*/,
+      0x00, 0x00, 0x00, 0x0C /*pod_struct.s.dheader*/,
+      0x00, 0x00, 0x00, 0x02 /*pod_struct.s.length*/,
+      0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04 /*pod_struct.s.data*/,
+      0x00, 0x00, 0x00, 0x08 /*pod_struct.a.dheader*/,
+      0x00, 0x05, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08 /*pod_struct.a*/
+      };
+  bytes PS_key {
+      'a' /*pod_struct.c*/
+      };
+
+  readwrite_test(PS, PS, PS_xcdr_v1_normal, PS_key, xcdr_v1_stream);
+  readwrite_test(PS, PS, PS_xcdr_v2_normal, PS_key, xcdr_v2_stream);
+
+  verify_pod_native<xcdr_v1_stream>(PS, false);
+  verify_pod_native<xcdr_v2_stream>(PS, true);
+}
+
 /*verifying reads/writes of structs containing bitmasks*/
 
 TEST_F(CDRStreamer, cdr_bitmask)
@@ -876,3 +1028,40 @@ TEST_F(CDRStreamer, cdr_bitmask)
   stream_test_union(BMU, BMK, union_normal, union_key);
 
 }
+
+/*verifying access to members of structs in their CDR representation through views*/
+
+TEST_F(CDRStreamer, cdr_view)
+{
+  view_buffer buf;
+  buf.buffer = BS_basic_normal.data();
+  buf.size = BS_basic_normal.size();
+  buf.swap = native_endianness() != endianness::big_endian;
+  buf.version = encoding_version::xcdr_v1;
+
+  view<basicstruct> BV(buf, 0);
+  ASSERT_TRUE(view_valid(BV));
+  EXPECT_EQ(view_end(BV), BS_basic_normal.size());
+  EXPECT_EQ(BV.l(), 123456);
+  EXPECT_EQ(BV.c(), 'g');
+  EXPECT_EQ(BV.str(), "abcdef");
+  EXPECT_EQ(BV.d(), 654.321);
+
+  buf.size--;
+  EXPECT_FALSE(view_valid(view<basicstruct>(buf, 0)));
+
+  buf.buffer = AS_xcdr_v2_normal.data();
+  buf.size = AS_xcdr_v2_normal.size();
+  buf.version = encoding_version::xcdr_v2;
+
+  view<appendablestruct> AV(buf, 0);
+  ASSERT_TRUE(view_valid(AV));
+  EXPECT_EQ(view_end(AV), AS_xcdr_v2_normal.size());
+  EXPECT_EQ(AV.l(), 123456);
+  EXPECT_EQ(AV.c(), 'g');
+  EXPECT_EQ(AV.str().str(), std::string("abcdef"));
+  EXPECT_EQ(AV.d(), 654.321);
+
+  buf.size--;
+  EXPECT_FALSE(view_valid(view<appendablestruct>(buf, 0)));
+}
@@ -449,10 +449,50 @@ TEST_F(Condition, query_condition)
     params.push_back("1");
     dds::sub::Query query = dds::sub::Query(reader, "long_1=%0", params);
 
-    // QueryCondition is currently not supported
-    ASSERT_THROW({ 
-        query_cond = dds::sub::cond::QueryCondition(query, dds::sub::status::DataState::any());
-    }, dds::core::UnsupportedError);
+    query_cond = dds::sub::cond::QueryCondition(query, dds::sub::status::DataState::any());
+    ASSERT_NE(query_cond, dds::core::null);
+
+    // Check expression and parameters
+    ASSERT_EQ(query_cond.expression(), "long_1=%0") << "The expression is not correct";
+    ASSERT_EQ(std::vector<std::string>(query_cond.begin(), query_cond.end()), params) << "The parameters are not correct";
+
+    // Check default trigger value
+    ASSERT_FALSE(query_cond.trigger_value()) << "The trigger_value is not correct (true)";
+
+    // Write sample that does not match and wait for data
+    writer << Space::Type1(2, 3, 4);
+    wait_for_data(reader);
+    ASSERT_FALSE(query_cond.trigger_value()) << "The trigger_value is not correct (true)";
+
+    // Write sample that does match and wait for data
+    writer << Space::Type1(1, 2, 3);
+    wait_for_data(reader);
+    ASSERT_TRUE(query_cond.trigger_value()) << "The trigger_value is not correct (false)";
+
+    // Only the matching sample is read through the condition
+    dds::sub::LoanedSamples<Space::Type1> samples = reader.select().content(query_cond).read();
+    ASSERT_EQ(samples.length(), 1u) << "The number of samples is incorrect";
+    ASSERT_EQ((*samples.begin()).data(), Space::Type1(1, 2, 3)) << "The returned sample is incorrect";
+
+    // Changed parameters apply to the samples already in the reader as well,
+    // and the condition remains attached to its waitset
+    dds::core::cond::WaitSet waitset;
+    waitset += query_cond;
+    params[0] = "3";
+    query_cond.parameters(params.begin(), params.end());
+    ASSERT_FALSE(query_cond.trigger_value()) << "The trigger_value is not correct (true)";
+    writer << Space::Type1(3, 4, 5);
+    dds::core::cond::WaitSet::ConditionSeq triggered = waitset.wait(dds::core::Duration::from_secs(5));
+    ASSERT_EQ(triggered.size(), 1u) << "The waitset was not triggered by the condition";
+    ASSERT_EQ(triggered[0], query_cond) << "The waitset was triggered by another condition";
+    samples = reader.select().content(query_cond).take();
+    ASSERT_EQ(samples.length(), 1u) << "The number of samples is incorrect";
+    ASSERT_EQ((*samples.begin()).data(), Space::Type1(3, 4, 5)) << "The returned sample is incorrect";
+    waitset -= query_cond;
+
+    // Check reader for this QueryCondition
+    dds::sub::AnyDataReader ar = query_cond.data_reader();
+    ASSERT_EQ(ar->get_ddsc_entity(), reader->get_ddsc_entity()) << "The returned reader is incorrect";
 }
 
 /**
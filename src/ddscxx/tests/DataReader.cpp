@@ -10,8 +10,12 @@
 
 #include "Util.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "dds/dds.hpp"
+#include "org/eclipse/cyclonedds/core/WorkerPool.hpp"
 #include "Space.hpp"
 
 /**
@@ -405,6 +409,87 @@ TEST_F(DataReader, read_instance_count_exceeds_bucket_size)
 }
 
 
+TEST_F(DataReader, take_concurrent)
+{
+    static const int32_t N_INSTANCES = 200;
+    static const size_t N_THREADS = 4;
+
+    /* Create and write data. */
+    const auto test_samples = this->WriteData(N_INSTANCES);
+
+    /* Take the samples one at a time from several threads at once. */
+    std::vector<std::vector<int32_t> > taken(N_THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < N_THREADS; t++) {
+        threads.emplace_back([this, &taken, t]() {
+            dds::sub::LoanedSamples<Space::Type1> samples;
+            while ((samples = this->reader.select().max_samples(1).take()).length() > 0) {
+                for (const auto& s: samples)
+                    taken[t].push_back(s.data().long_1());
+            }
+        });
+    }
+    for (auto& th: threads)
+        th.join();
+
+    /* Check that every sample was taken exactly once. */
+    std::vector<int32_t> keys;
+    for (const auto& t: taken)
+        keys.insert(keys.end(), t.begin(), t.end());
+    std::sort(keys.begin(), keys.end());
+    ASSERT_EQ(keys.size(), test_samples.size());
+    for (size_t i = 0; i < keys.size(); i++)
+        ASSERT_EQ(keys[i], test_samples[i].long_1());
+}
+
+
+TEST_F(DataReader, take_parallel_deserialization)
+{
+    static const int32_t N_INSTANCES = 50;
+
+    /* Write data as CDR (CDR_BE, no options), the writer does not keep these
+     * samples deserialized, so the reader has to deserialize them. */
+    std::vector<Space::Type1> test_samples;
+    this->SetupCommunication();
+    for (int32_t i = 0; i < N_INSTANCES; i++) {
+        test_samples.push_back(Space::Type1(i, i+1, i+2));
+        std::vector<uint8_t> serialized{0x00, 0x00, 0x00, 0x00};
+        for (int32_t v: {i, i+1, i+2}) {
+            for (int shift = 24; shift >= 0; shift -= 8)
+                serialized.push_back(static_cast<uint8_t>(static_cast<uint32_t>(v) >> shift));
+        }
+        this->writer->write_cdr(std::move(serialized));
+    }
+
+    /* Count the tasks executed by the pool. */
+    std::atomic<size_t> executed{0};
+    const org::eclipse::cyclonedds::core::ParallelExecutor pool =
+            org::eclipse::cyclonedds::core::WorkerPool::executor(3);
+    this->reader->parallel_deserialization(
+        [pool, &executed](size_t count, const std::function<void(size_t)>& task) {
+            pool(count, [&task, &executed](size_t i) {
+                task(i);
+                executed++;
+            });
+        }, 8);
+
+    /* Check the order of samples deserialized in parallel, for loans and iterators. */
+    dds::sub::LoanedSamples<Space::Type1> loaned = this->reader.read();
+    ASSERT_EQ(executed.load(), static_cast<size_t>(N_INSTANCES));
+    this->CheckData(loaned, test_samples);
+
+    std::vector<dds::sub::Sample<Space::Type1> > samples(N_INSTANCES);
+    ASSERT_EQ(this->reader.take(samples.begin(), N_INSTANCES), static_cast<uint32_t>(N_INSTANCES));
+    ASSERT_EQ(executed.load(), static_cast<size_t>(2 * N_INSTANCES));
+    this->CheckData(samples, test_samples);
+
+    /* Back to deserializing while collecting. */
+    this->reader->parallel_deserialization(nullptr, 0);
+    loaned = this->reader.read();
+    ASSERT_EQ(loaned.length(), 0u);
+}
+
+
 TEST_F(DataReader, read_no_data)
 {
     dds::sub::LoanedSamples<Space::Type1> samples;
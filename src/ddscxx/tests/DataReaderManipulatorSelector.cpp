@@ -11,6 +11,8 @@
 #include "Util.hpp"
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "dds/dds.hpp"
 #include "Space.hpp"
 
@@ -140,6 +142,44 @@ public:
         }
     }
 
+    /*
+     * Reads instance by instance, read_next reads the samples of the instance
+     * following the given handle, and checks that all instances are visited
+     * once, in the order of their instance handles.
+     */
+    template <typename READ_NEXT>
+    void CheckNextInstances (
+        READ_NEXT read_next,
+        int32_t instances_start,
+        int32_t instances_end,
+        int32_t samples_start,
+        int32_t samples_end)
+    {
+        dds::core::InstanceHandle ih = dds::core::InstanceHandle::nil();
+        std::vector<dds::sub::Sample<Space::Type1> > samples;
+        std::set<int32_t> instances;
+
+        read_next(ih, samples);
+        while (!samples.empty()) {
+            const dds::core::InstanceHandle next = samples.front().info().instance_handle();
+            const int32_t instance = samples.front().data().long_1();
+            ASSERT_TRUE(next > ih);
+            ASSERT_TRUE(instances.insert(instance).second);
+            std::vector<dds::sub::Sample<Space::Type1> >::const_iterator it;
+            for (it = samples.begin(); it != samples.end(); ++it) {
+                ASSERT_TRUE(it->info().instance_handle() == next);
+            }
+            this->CheckData(samples, this->CreateSamples(instance, instance, samples_start, samples_end));
+
+            ih = next;
+            samples.clear();
+            read_next(ih, samples);
+        }
+        ASSERT_EQ(instances.size(), static_cast<size_t>(instances_end - instances_start + 1));
+        ASSERT_EQ(*instances.begin(), instances_start);
+        ASSERT_EQ(*instances.rbegin(), instances_end);
+    }
+
     void TearDown()
     {
         this->writer = dds::core::null;
@@ -239,42 +279,27 @@ TEST_F(DataReaderManipulatorSelector, implicit_instance)
 
 TEST_F(DataReaderManipulatorSelector, implicit_next_instance)
 {
-    dds::sub::LoanedSamples<Space::Type1> read_samples;
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        this->reader >> dds::sub::next_instance(ih) >> read_samples;
-
-        /* Check result. */
-        this->CheckData(read_samples, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        this->reader >> dds::sub::next_instance(ih) >> read_samples;
-
-        /* Check result. */
-        this->CheckData(read_samples, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            dds::sub::LoanedSamples<Space::Type1> read_samples;
+            this->reader >> dds::sub::next_instance(ih) >> read_samples;
+            dds::sub::LoanedSamples<Space::Type1>::const_iterator it;
+            for (it = read_samples.begin(); it != read_samples.end(); ++it) {
+                samples.push_back(dds::sub::Sample<Space::Type1>(it->data(), it->info()));
+            }
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderManipulatorSelector, implicit_state)
@@ -312,7 +337,7 @@ TEST_F(DataReaderManipulatorSelector, implicit_content)
     std::vector<Space::Type1> write_samples;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -327,14 +352,11 @@ TEST_F(DataReaderManipulatorSelector, implicit_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        this->reader >> dds::sub::content(query) >> read_samples;
+    /* Read through the Selector. */
+    this->reader >> dds::sub::content(query) >> read_samples;
 
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
 }
 
 TEST_F(DataReaderManipulatorSelector, implicit_max_samples)
@@ -472,44 +494,28 @@ TEST_F(DataReaderManipulatorSelector, explicit_instance)
 TEST_F(DataReaderManipulatorSelector, explicit_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::ManipulatorSelector manipulator(this->reader);
-    dds::sub::LoanedSamples<Space::Type1> read_samples;
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        manipulator.next_instance(ih);
-
-        /* Read through the Selector. */
-        manipulator >> read_samples;
-
-        /* Check result. */
-        this->CheckData(read_samples, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        manipulator >> read_samples;
-
-        /* Check result. */
-        this->CheckData(read_samples, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            dds::sub::LoanedSamples<Space::Type1> read_samples;
+            manipulator.next_instance(ih);
+            manipulator >> read_samples;
+            dds::sub::LoanedSamples<Space::Type1>::const_iterator it;
+            for (it = read_samples.begin(); it != read_samples.end(); ++it) {
+                samples.push_back(dds::sub::Sample<Space::Type1>(it->data(), it->info()));
+            }
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderManipulatorSelector, explicit_state)
@@ -550,7 +556,7 @@ TEST_F(DataReaderManipulatorSelector, explicit_content)
     std::vector<Space::Type1> write_samples;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -565,16 +571,13 @@ TEST_F(DataReaderManipulatorSelector, explicit_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        manipulator.content(query);
+    manipulator.content(query);
 
-        /* Read through the Selector. */
-        manipulator >> read_samples;
+    /* Read through the Selector. */
+    manipulator >> read_samples;
 
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
 }
 
 TEST_F(DataReaderManipulatorSelector, explicit_max_samples)
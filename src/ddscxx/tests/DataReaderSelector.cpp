@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "dds/dds.hpp"
 #include "Util.hpp"
 #include "Space.hpp"
@@ -144,6 +146,44 @@ public:
         }
     }
 
+    /*
+     * Reads instance by instance, read_next reads the samples of the instance
+     * following the given handle, and checks that all instances are visited
+     * once, in the order of their instance handles.
+     */
+    template <typename READ_NEXT>
+    void CheckNextInstances (
+        READ_NEXT read_next,
+        int32_t instances_start,
+        int32_t instances_end,
+        int32_t samples_start,
+        int32_t samples_end)
+    {
+        dds::core::InstanceHandle ih = dds::core::InstanceHandle::nil();
+        std::vector<dds::sub::Sample<Space::Type1> > samples;
+        std::set<int32_t> instances;
+
+        read_next(ih, samples);
+        while (!samples.empty()) {
+            const dds::core::InstanceHandle next = samples.front().info().instance_handle();
+            const int32_t instance = samples.front().data().long_1();
+            ASSERT_TRUE(next > ih);
+            ASSERT_TRUE(instances.insert(instance).second);
+            std::vector<dds::sub::Sample<Space::Type1> >::const_iterator it;
+            for (it = samples.begin(); it != samples.end(); ++it) {
+                ASSERT_TRUE(it->info().instance_handle() == next);
+            }
+            this->CheckData(samples, this->CreateSamples(instance, instance, samples_start, samples_end));
+
+            ih = next;
+            samples.clear();
+            read_next(ih, samples);
+        }
+        ASSERT_EQ(instances.size(), static_cast<size_t>(instances_end - instances_start + 1));
+        ASSERT_EQ(*instances.begin(), instances_start);
+        ASSERT_EQ(*instances.rbegin(), instances_end);
+    }
+
     void TearDown()
     {
         this->writer = dds::core::null;
@@ -219,42 +259,26 @@ TEST_F(DataReaderSelector, implicit_instance)
 
 TEST_F(DataReaderSelector, implicit_next_instance)
 {
-    dds::sub::LoanedSamples<Space::Type1> read_samples;
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        read_samples = this->reader.select().next_instance(ih).read();
-
-        /* Check result. */
-        this->CheckData(read_samples, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        read_samples = this->reader.select().next_instance(ih).read();
-
-        /* Check result. */
-        this->CheckData(read_samples, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            dds::sub::LoanedSamples<Space::Type1> read_samples = this->reader.select().next_instance(ih).read();
+            dds::sub::LoanedSamples<Space::Type1>::const_iterator it;
+            for (it = read_samples.begin(); it != read_samples.end(); ++it) {
+                samples.push_back(dds::sub::Sample<Space::Type1>(it->data(), it->info()));
+            }
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderSelector, implicit_state)
@@ -292,7 +316,7 @@ TEST_F(DataReaderSelector, implicit_content)
     std::vector<Space::Type1> write_samples;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -307,14 +331,42 @@ TEST_F(DataReaderSelector, implicit_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        read_samples = this->reader.select().content(query).read();
+    /* Read through the Selector. */
+    read_samples = this->reader.select().content(query).read();
+
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
+}
+
+TEST_F(DataReaderSelector, implicit_content_key)
+{
+    dds::sub::LoanedSamples<Space::Type1> read_samples;
+    std::vector<Space::Type1> write_samples;
+
+    /* Create query on the key, so that only one instance is looked at. */
+    std::vector<std::string> params(1, "2");
+    dds::sub::Query query(this->reader, "long_1 = %0", params);
+
+    /* Write data. */
+    write_samples = this->CreateSamples(1, 5,  /* instances */
+                                        0, 2); /* samples   */
+    this->WriteData(write_samples);
 
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Read through the Selector. */
+    read_samples = this->reader.select().content(query).read();
+    this->CheckData(read_samples, this->CreateSamples(2, 2, 0, 2));
+
+    /* The instance follows the changed parameters. */
+    params[0] = "4";
+    query.parameters(params.begin(), params.end());
+    read_samples = this->reader.select().content(query).read();
+    this->CheckData(read_samples, this->CreateSamples(4, 4, 0, 2));
+
+    /* No samples for an unknown instance. */
+    params[0] = "7";
+    query.parameters(params.begin(), params.end());
+    read_samples = this->reader.select().content(query).read();
+    ASSERT_EQ(read_samples.length(), 0u);
 }
 
 TEST_F(DataReaderSelector, implicit_max_samples)
@@ -423,43 +475,27 @@ TEST_F(DataReaderSelector, read_LoanedSamples_instance)
 TEST_F(DataReaderSelector, read_LoanedSamples_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    dds::sub::LoanedSamples<Space::Type1> read_samples;
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        selector.next_instance(ih);
-        read_samples = selector.read();
-
-        /* Check result. */
-        this->CheckData(read_samples, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        read_samples = selector.read();
-
-        /* Check result. */
-        this->CheckData(read_samples, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            selector.next_instance(ih);
+            dds::sub::LoanedSamples<Space::Type1> read_samples = selector.read();
+            dds::sub::LoanedSamples<Space::Type1>::const_iterator it;
+            for (it = read_samples.begin(); it != read_samples.end(); ++it) {
+                samples.push_back(dds::sub::Sample<Space::Type1>(it->data(), it->info()));
+            }
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderSelector, read_LoanedSamples_state)
@@ -500,7 +536,7 @@ TEST_F(DataReaderSelector, read_LoanedSamples_content)
     std::vector<Space::Type1> write_samples;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -515,15 +551,12 @@ TEST_F(DataReaderSelector, read_LoanedSamples_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        selector.content(query);
-        read_samples = selector.read();
+    /* Read through the Selector. */
+    selector.content(query);
+    read_samples = selector.read();
 
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, read_LoanedSamples_max_samples)
@@ -642,47 +675,25 @@ TEST_F(DataReaderSelector, read_FWIterator_instance)
 TEST_F(DataReaderSelector, read_FWIterator_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
-    uint32_t cnt;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples2(expected2_samples.size());
-        selector.next_instance(ih);
-        cnt = selector.read(read_samples2.begin(), static_cast<uint32_t>(read_samples2.size()));
-        ASSERT_EQ(cnt, read_samples2.size());
-
-        /* Check result. */
-        this->CheckData(read_samples2, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples3(expected3_samples.size());
-        cnt = selector.read(read_samples3.begin(), static_cast<uint32_t>(read_samples3.size()));
-        ASSERT_EQ(cnt, read_samples3.size());
-
-        /* Check result. */
-        this->CheckData(read_samples3, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            samples.resize(16);
+            selector.next_instance(ih);
+            uint32_t cnt = selector.read(samples.begin(), static_cast<uint32_t>(samples.size()));
+            samples.resize(cnt);
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderSelector, read_FWIterator_state)
@@ -725,7 +736,7 @@ TEST_F(DataReaderSelector, read_FWIterator_content)
     uint32_t cnt;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -740,17 +751,14 @@ TEST_F(DataReaderSelector, read_FWIterator_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples(expected_samples.size());
-        selector.content(query);
-        cnt = selector.read(read_samples.begin(), static_cast<uint32_t>(read_samples.size()));
-        ASSERT_EQ(cnt, read_samples.size());
-
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Read through the Selector. */
+    std::vector<dds::sub::Sample<Space::Type1> > read_samples(expected_samples.size());
+    selector.content(query);
+    cnt = selector.read(read_samples.begin(), static_cast<uint32_t>(read_samples.size()));
+    ASSERT_EQ(cnt, read_samples.size());
+
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, read_FWIterator_max_samples)
@@ -877,49 +885,24 @@ TEST_F(DataReaderSelector, read_BIIterator_instance)
 TEST_F(DataReaderSelector, read_BIIterator_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
-    uint32_t cnt;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples2;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter2(read_samples2);
-        selector.next_instance(ih);
-        cnt = selector.read(biter2);
-        ASSERT_EQ(cnt, expected2_samples.size());
-
-        /* Check result. */
-        this->CheckData(read_samples2, expected2_samples);
-
-        /* Another read should read the next instance. */
-
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples3;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter3(read_samples3);
-        cnt = selector.read(biter3);
-        ASSERT_EQ(cnt, expected3_samples.size());
-
-        /* Check result. */
-        this->CheckData(read_samples3, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(samples);
+            selector.next_instance(ih);
+            selector.read(biter);
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 }
 
 TEST_F(DataReaderSelector, read_BIIterator_state)
@@ -963,7 +946,7 @@ TEST_F(DataReaderSelector, read_BIIterator_content)
     uint32_t cnt;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -978,18 +961,15 @@ TEST_F(DataReaderSelector, read_BIIterator_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > read_samples;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(read_samples);
-        selector.content(query);
-        cnt = selector.read(biter);
-        ASSERT_EQ(cnt, expected_samples.size());
-
-        /* Check result. */
-        this->CheckData(read_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Read through the Selector. */
+    std::vector<dds::sub::Sample<Space::Type1> > read_samples;
+    std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(read_samples);
+    selector.content(query);
+    cnt = selector.read(biter);
+    ASSERT_EQ(cnt, expected_samples.size());
+
+    /* Check result. */
+    this->CheckData(read_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, read_BIIterator_max_samples)
@@ -1109,43 +1089,58 @@ TEST_F(DataReaderSelector, take_LoanedSamples_instance)
 TEST_F(DataReaderSelector, take_LoanedSamples_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    dds::sub::LoanedSamples<Space::Type1> take_samples;
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            selector.next_instance(ih);
+            dds::sub::LoanedSamples<Space::Type1> read_samples = selector.take();
+            dds::sub::LoanedSamples<Space::Type1>::const_iterator it;
+            for (it = read_samples.begin(); it != read_samples.end(); ++it) {
+                samples.push_back(dds::sub::Sample<Space::Type1>(it->data(), it->info()));
+            }
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
 
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        selector.next_instance(ih);
-        take_samples = selector.take();
+    /* All instances should have been taken. */
+    ASSERT_EQ(this->reader.read().length(), 0u);
+}
 
-        /* Check result. */
-        this->CheckData(take_samples, expected2_samples);
+TEST_F(DataReaderSelector, take_LoanedSamples_next_instance_new_instances)
+{
+    dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
 
-        /* Another take should take the next instance. */
+    /* Take all instances one by one, until next_instance finds no more. */
+    auto take_instances = [&]() {
+        size_t instances = 0;
+        dds::core::InstanceHandle ih = dds::core::null;
+        for (;;) {
+            selector.next_instance(ih);
+            dds::sub::LoanedSamples<Space::Type1> samples = selector.take();
+            if (samples.length() == 0)
+                break;
+            ih = samples.begin()->info().instance_handle();
+            instances++;
+        }
+        return instances;
+    };
 
-        /* Read through the Selector. */
-        take_samples = selector.take();
+    this->WriteData(this->CreateSamples(1, 3, 1, 1));
+    ASSERT_EQ(take_instances(), 3u);
 
-        /* Check result. */
-        this->CheckData(take_samples, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Instances created after the first iteration must be found by the next one. */
+    this->WriteData(this->CreateSamples(4, 5, 1, 1));
+    ASSERT_EQ(take_instances(), 2u);
+    ASSERT_EQ(this->reader.read().length(), 0u);
 }
 
 TEST_F(DataReaderSelector, take_LoanedSamples_state)
@@ -1186,7 +1181,7 @@ TEST_F(DataReaderSelector, take_LoanedSamples_content)
     std::vector<Space::Type1> write_samples;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -1201,15 +1196,12 @@ TEST_F(DataReaderSelector, take_LoanedSamples_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        selector.content(query);
-        take_samples = selector.take();
+    /* Read through the Selector. */
+    selector.content(query);
+    take_samples = selector.take();
 
-        /* Check result. */
-        this->CheckData(take_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Check result. */
+    this->CheckData(take_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, take_LoanedSamples_max_samples)
@@ -1327,47 +1319,28 @@ TEST_F(DataReaderSelector, take_FWIterator_instance)
 TEST_F(DataReaderSelector, take_FWIterator_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
-    uint32_t cnt;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples2(expected2_samples.size());
-        selector.next_instance(ih);
-        cnt = selector.take(take_samples2.begin(), static_cast<uint32_t>(take_samples2.size()));
-        ASSERT_EQ(cnt, take_samples2.size());
-
-        /* Check result. */
-        this->CheckData(take_samples2, expected2_samples);
-
-        /* Another take should take the next instance. */
-
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples3(expected3_samples.size());
-        cnt = selector.take(take_samples3.begin(), static_cast<uint32_t>(take_samples3.size()));
-        ASSERT_EQ(cnt, take_samples3.size());
-
-        /* Check result. */
-        this->CheckData(take_samples3, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            samples.resize(16);
+            selector.next_instance(ih);
+            uint32_t cnt = selector.take(samples.begin(), static_cast<uint32_t>(samples.size()));
+            samples.resize(cnt);
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
+
+    /* All instances should have been taken. */
+    ASSERT_EQ(this->reader.read().length(), 0u);
 }
 
 TEST_F(DataReaderSelector, take_FWIterator_state)
@@ -1410,7 +1383,7 @@ TEST_F(DataReaderSelector, take_FWIterator_content)
     uint32_t cnt;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -1425,17 +1398,14 @@ TEST_F(DataReaderSelector, take_FWIterator_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples(expected_samples.size());
-        selector.content(query);
-        cnt = selector.take(take_samples.begin(), static_cast<uint32_t>(take_samples.size()));
-        ASSERT_EQ(cnt, take_samples.size());
-
-        /* Check result. */
-        this->CheckData(take_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Read through the Selector. */
+    std::vector<dds::sub::Sample<Space::Type1> > take_samples(expected_samples.size());
+    selector.content(query);
+    cnt = selector.take(take_samples.begin(), static_cast<uint32_t>(take_samples.size()));
+    ASSERT_EQ(cnt, take_samples.size());
+
+    /* Check result. */
+    this->CheckData(take_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, take_FWIterator_max_samples)
@@ -1562,49 +1532,27 @@ TEST_F(DataReaderSelector, take_BIIterator_instance)
 TEST_F(DataReaderSelector, take_BIIterator_next_instance)
 {
     dds::sub::DataReader<Space::Type1>::Selector selector(this->reader);
-    std::vector<Space::Type1> expected2_samples;
-    std::vector<Space::Type1> expected3_samples;
     std::vector<Space::Type1> write_samples;
-    dds::core::InstanceHandle ih;
-    uint32_t cnt;
 
     /* Get test data. */
     write_samples = this->CreateSamples(1, 5,  /* instances */
                                         3, 5); /* samples   */
-    expected2_samples = this->CreateSamples(2, 2,  /* instances */
-                                            3, 5); /* samples   */
-    expected3_samples = this->CreateSamples(3, 3,  /* instances */
-                                            3, 5); /* samples   */
 
     /* Write data. */
     this->WriteData(write_samples);
 
-    /* Get an instance handle. */
-    ih = this->reader.lookup_instance(Space::Type1(2,0,0));
-
-    /* TODO: Getting sample of next instance is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples2;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter2(take_samples2);
-        selector.next_instance(ih);
-        cnt = selector.take(biter2);
-        ASSERT_EQ(cnt, expected2_samples.size());
-
-        /* Check result. */
-        this->CheckData(take_samples2, expected2_samples);
-
-        /* Another take should take the next instance. */
-
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples3;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter3(take_samples3);
-        cnt = selector.take(biter3);
-        ASSERT_EQ(cnt, expected3_samples.size());
-
-        /* Check result. */
-        this->CheckData(take_samples3, expected3_samples);
-    }, dds::core::UnsupportedError);
+    /* Read instance by instance through the Selector. */
+    this->CheckNextInstances(
+        [&](const dds::core::InstanceHandle& ih, std::vector<dds::sub::Sample<Space::Type1> >& samples) {
+            std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(samples);
+            selector.next_instance(ih);
+            selector.take(biter);
+        },
+        1, 5,  /* instances */
+        3, 5); /* samples   */
+
+    /* All instances should have been taken. */
+    ASSERT_EQ(this->reader.read().length(), 0u);
 }
 
 TEST_F(DataReaderSelector, take_BIIterator_state)
@@ -1648,7 +1596,7 @@ TEST_F(DataReaderSelector, take_BIIterator_content)
     uint32_t cnt;
 
     /* Create query. */
-    const char *paramsinit[] = {"2", "3", "4"};
+    const char *paramsinit[] = {"2", "4", "5"};
     std::vector<std::string> params(paramsinit, paramsinit+3);
     std::string expression = "long_1 = %0 and long_2 = %1 and long_3 = %2";
     dds::sub::Query query(this->reader, expression, params);
@@ -1663,18 +1611,15 @@ TEST_F(DataReaderSelector, take_BIIterator_content)
     this->WriteData(write_samples);
 
 
-    /* TODO: Getting sample with query is not yet supported. */
-    ASSERT_THROW({
-        /* Read through the Selector. */
-        std::vector<dds::sub::Sample<Space::Type1> > take_samples;
-        std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(take_samples);
-        selector.content(query);
-        cnt = selector.take(biter);
-        ASSERT_EQ(cnt, expected_samples.size());
-
-        /* Check result. */
-        this->CheckData(take_samples, expected_samples);
-    }, dds::core::UnsupportedError);
+    /* Read through the Selector. */
+    std::vector<dds::sub::Sample<Space::Type1> > take_samples;
+    std::back_insert_iterator< std::vector<dds::sub::Sample<Space::Type1> > > biter(take_samples);
+    selector.content(query);
+    cnt = selector.take(biter);
+    ASSERT_EQ(cnt, expected_samples.size());
+
+    /* Check result. */
+    this->CheckData(take_samples, expected_samples);
 }
 
 TEST_F(DataReaderSelector, take_BIIterator_max_samples)
@@ -12,6 +12,8 @@
 #include "dds/dds.hpp"
 #include <gtest/gtest.h>
 #include "Space.hpp"
+#include <iterator>
+#include <set>
 
 
 
@@ -444,6 +446,42 @@ TEST_F(DataWriter, write_iter)
     ReadAndCheckSampleType1(samples[1], notReadState, true);
 }
 
+/* Forward iterator returning the samples it creates by value. */
+class Type1Generator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Space::Type1 value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Space::Type1* pointer;
+    typedef Space::Type1 reference;
+
+    explicit Type1Generator(int32_t i) : i_(i) { }
+    Space::Type1 operator*() const { return Space::Type1(i_, i_ + 1, i_ + 2); }
+    Type1Generator& operator++() { ++i_; return *this; }
+    bool operator==(const Type1Generator& other) const { return i_ == other.i_; }
+    bool operator!=(const Type1Generator& other) const { return i_ != other.i_; }
+
+private:
+    int32_t i_;
+};
+
+TEST_F(DataWriter, write_iter_by_value)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    this->SetupCommunication(false);
+
+    this->writer.write(Type1Generator(1), Type1Generator(4));
+
+    ReadAndCheckSampleType1(Space::Type1(1, 2, 3), notReadState, true);
+    ReadAndCheckSampleType1(Space::Type1(2, 3, 4), notReadState, true);
+    ReadAndCheckSampleType1(Space::Type1(3, 4, 5), notReadState, true);
+}
+
 TEST_F(DataWriter, write_data_with_timestamp)
 {
     Space::Type1 testData1(1,1,1);
@@ -592,6 +630,66 @@ TEST_F(DataWriter, write_cdr)
     ReadAndCheckSampleType1(testData, notReadState, true);
 }
 
+TEST_F(DataWriter, write_cdr_adopt)
+{
+    Space::Type1 testData(0,1,2);
+    this->SetupCommunication(false);
+
+    /* Encoding (CDR_BE, no options) followed by the payload, moved into the writer. */
+    std::vector<uint8_t> serialized{0x00,0x00,0x00,0x00,
+                                    0x00,0x00,0x00,0x00, 0x00,0x00,0x00,0x01, 0x00,0x00,0x00,0x02};
+    this->writer->write_cdr(std::move(serialized));
+
+    dds::sub::status::DataState notReadState(dds::sub::status::SampleState::not_read(),
+                                             dds::sub::status::ViewState::new_view(),
+                                             dds::sub::status::InstanceState::alive());
+    ReadAndCheckSampleType1(testData, notReadState, true);
+
+    /* A buffer without a valid encoding is rejected. */
+    std::vector<uint8_t> invalid{0x00,0x00};
+    ASSERT_THROW(this->writer->write_cdr(std::move(invalid)), dds::core::Error);
+
+    /* A buffer that is not padded to a multiple of 4 bytes is rejected, not copied. */
+    std::vector<uint8_t> unpadded{0x00,0x00,0x00,0x00,
+                                  0x00,0x00,0x00,0x00, 0x00,0x00,0x00,0x01, 0x00,0x00,0x00};
+    ASSERT_THROW(this->writer->write_cdr(std::move(unpadded)), dds::core::Error);
+    ASSERT_EQ(unpadded.size(), 15u);
+}
+
+TEST_F(DataWriter, write_serialized)
+{
+    Space::Type1 testData(0,1,2);
+    this->SetupWriter(false);
+    this->SetupReader(false);
+
+    /* Keep all, so that the writes of both writers are retained. */
+    dds::sub::qos::DataReaderQos rqos = this->subscriber.default_datareader_qos();
+    rqos << dds::core::policy::History::KeepAll();
+    dds::sub::DataReader<Space::Type1> keepall_reader(this->subscriber, this->topic, rqos);
+
+    dds::pub::DataWriter<Space::Type1> writer1(this->publisher, this->topic);
+    dds::pub::DataWriter<Space::Type1> writer2(this->publisher, this->topic);
+
+    /* Serialize once, write to both writers. */
+    org::eclipse::cyclonedds::pub::SerializedSample<Space::Type1> serialized(this->topic, testData);
+    org::eclipse::cyclonedds::pub::SerializedSample<Space::Type1> copy(serialized);
+    ASSERT_EQ(copy.serdata(), serialized.serdata());
+
+    writer1->write_serialized(serialized);
+    writer2->write_serialized(copy);
+
+    /* Check result. */
+    dds::sub::LoanedSamples<Space::Type1> samples = keepall_reader.take();
+    ASSERT_EQ(samples.length(), 2u);
+    std::set<dds::core::InstanceHandle> publications;
+    for (auto it = samples.begin(); it != samples.end(); ++it) {
+        ASSERT_EQ(it->data(), testData);
+        ASSERT_EQ(it->info().state().instance_state(), dds::sub::status::InstanceState::alive());
+        publications.insert(it->info().publication_handle());
+    }
+    ASSERT_EQ(publications.size(), 2u);
+}
+
 TEST_F(DataWriter, writedispose)
 {
     Space::Type1 testData0(0,0,0);
@@ -627,6 +725,32 @@ TEST_F(DataWriter, writedispose)
     ReadAndCheckSampleType1(testData3, viewedDisposedState,  true);
 }
 
+TEST_F(DataWriter, writedispose_range)
+{
+    dds::sub::status::DataState notReadDisposedState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::not_alive_disposed());
+
+    std::vector<Space::Type1> samples;
+    samples.push_back(Space::Type1(1, 2, 3));
+    samples.push_back(Space::Type1(2, 3, 4));
+    samples.push_back(Space::Type1(3, 4, 5));
+
+    std::vector<dds::core::InstanceHandle> handles(2, dds::core::null);
+
+    this->SetupCommunication(true);
+
+    /* The handles range is shorter, so only the first two samples are written. */
+    this->writer->writedispose(samples.begin(), samples.end(), handles.begin(), handles.end());
+
+    ReadAndCheckSampleType1(samples[0], notReadDisposedState, true);
+    ReadAndCheckSampleType1(samples[1], notReadDisposedState, true);
+
+    std::vector<dds::sub::Sample<Space::Type1> > remaining(1);
+    ASSERT_EQ(this->reader.take(remaining.begin(), 1), 0u);
+}
+
 TEST_F(DataWriter, dispose_instance)
 {
     static const int32_t MAX_INSTANCES =  5;
@@ -1031,6 +1155,11 @@ TEST_F(DataWriter, use_after_close)
         this->writer.write(samples.begin(), samples.end());
     }, dds::core::AlreadyClosedError);
 
+    ASSERT_THROW({
+        std::vector<Space::Type1> samples;
+        this->writer.write(samples.begin(), samples.end());
+    }, dds::core::AlreadyClosedError);
+
     ASSERT_THROW({
         this->writer.write(testData, this->participant.current_time());
     }, dds::core::AlreadyClosedError);
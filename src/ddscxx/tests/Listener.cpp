@@ -8,6 +8,7 @@
 //
 // SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <gtest/gtest.h>
@@ -272,6 +273,65 @@ protected:
     }
 };
 
+/* Set on the threads of a tagged executor while they execute its tasks. */
+static thread_local bool in_tagged_executor = false;
+
+static org::eclipse::cyclonedds::core::TaskExecutor
+tagged_executor(const org::eclipse::cyclonedds::core::TaskExecutor& executor)
+{
+    return [executor](std::function<void()> task) {
+        executor([task]() {
+            in_tagged_executor = true;
+            task();
+            in_tagged_executor = false;
+        });
+    };
+}
+
+/* Takes the samples on data available, signalling when the expected number of
+ * samples was received and recording whether invocations overlapped. */
+class OffloadedDataReaderListener : public virtual dds::sub::NoOpDataReaderListener<HelloWorldData::Msg>
+{
+public:
+    std::atomic<bool> overlapped;
+    uint32_t received;
+    uint32_t invoked;
+    uint32_t invoked_offloaded;
+
+    explicit OffloadedDataReaderListener(uint32_t expected) :
+        overlapped(false), received(0), invoked(0), invoked_offloaded(0),
+        expected_(expected), running_(0) { }
+
+protected:
+    virtual void on_data_available(dds::sub::DataReader<HelloWorldData::Msg>& reader)
+    {
+        if (this->running_.fetch_add(1) != 0)
+            this->overlapped = true;
+        // Slow enough for notifications to arrive while the listener runs.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        dds::sub::LoanedSamples<HelloWorldData::Msg> samples = reader.take();
+        uint32_t valid = 0;
+        for (const auto& sample : samples) {
+            if (sample.info().valid())
+                valid++;
+        }
+        this->running_--;
+
+        ddsrt_mutex_lock(&g_mutex);
+        this->received += valid;
+        this->invoked++;
+        if (in_tagged_executor)
+            this->invoked_offloaded++;
+        if (this->received == this->expected_)
+            cb_called |= DDS_DATA_AVAILABLE_STATUS;
+        ddsrt_cond_mtime_broadcast(&g_cond);
+        ddsrt_mutex_unlock(&g_mutex);
+    }
+
+private:
+    const uint32_t expected_;
+    std::atomic<int> running_;
+};
 
 static uint32_t waitfor_cb(uint32_t expected, dds_duration_t timeout)
 {
@@ -1322,6 +1382,49 @@ TEST_F(Listener, data_available)
     ASSERT_FALSE(reader.status_changes().test(DDS_DATA_AVAILABLE_STATUS_ID));
 }
 
+TEST_F(Listener, data_available_executor)
+{
+    const uint32_t count = 100;
+    OffloadedDataReaderListener readerListener(count);
+    dds::core::status::StatusMask mask =
+        dds::core::status::StatusMask() <<
+        dds::core::status::StatusMask::data_available();
+    dds::sub::qos::DataReaderQos qos =
+        dds::sub::qos::DataReaderQos() <<
+        dds::core::policy::Reliability::Reliable() <<
+        dds::core::policy::History::KeepAll();
+    uint32_t triggered;
+
+    // Create reader with listener, invoked through a pool of two threads
+    dds::sub::DataReader<HelloWorldData::Msg> reader(
+        subscriber, topic, qos, &readerListener, mask);
+    ASSERT_NE(reader, dds::core::null);
+    reader->listener_executor(tagged_executor(org::eclipse::cyclonedds::core::WorkerPool::task_executor(2)));
+
+    // Create writer
+    dds::pub::DataWriter<HelloWorldData::Msg> writer(
+        publisher, topic);
+    ASSERT_NE(writer, dds::core::null);
+
+    // Write samples
+    for (int32_t i = 0; i < static_cast<int32_t>(count); i++)
+        writer << HelloWorldData::Msg(i, "test");
+
+    // All samples should be taken by the listener, on a pool thread and
+    // never by two invocations at the same time
+    triggered = waitfor_cb(DDS_DATA_AVAILABLE_STATUS);
+    ASSERT_EQ(triggered & DDS_DATA_AVAILABLE_STATUS, DDS_DATA_AVAILABLE_STATUS);
+    ddsrt_mutex_lock(&g_mutex);
+    uint32_t received = readerListener.received;
+    uint32_t invoked = readerListener.invoked;
+    uint32_t invoked_offloaded = readerListener.invoked_offloaded;
+    ddsrt_mutex_unlock(&g_mutex);
+    ASSERT_EQ(received, count);
+    ASSERT_GT(invoked, 0u);
+    ASSERT_EQ(invoked_offloaded, invoked);
+    ASSERT_FALSE(readerListener.overlapped);
+}
+
 TEST_F(Listener, data_available_subscriber)
 {
     SubscriberListener subscriberListener;
@@ -14,6 +14,10 @@
 #include "HelloWorldData.hpp"
 #include "Space.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 
 class TestPublisherListener : public virtual dds::pub::NoOpPublisherListener { };
 
@@ -245,3 +249,40 @@ TEST_F(Publisher, use_after_deletion)
         this->publisher.participant();
     }, dds::core::NullReferenceError);
 }
+
+/*
+ * Checking that publishers created, looked up and closed concurrently from several
+ * threads, and thus spread over the shards of the entity map, are found by their handles.
+ */
+TEST_F(Publisher, concurrent_entity_map)
+{
+    const size_t n_threads = 8;
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < n_threads; t++) {
+        threads.emplace_back([this, &mismatches]() {
+            const size_t n_publishers = 32;
+            std::vector<dds::pub::Publisher> publishers;
+            for (size_t i = 0; i < n_publishers; i++) {
+                publishers.push_back(dds::pub::Publisher(this->participant));
+            }
+            for (const dds::pub::Publisher& p : publishers) {
+                const org::eclipse::cyclonedds::core::ObjectDelegate* expected = p.delegate().get();
+                org::eclipse::cyclonedds::core::ObjectDelegate::ref_type found =
+                    org::eclipse::cyclonedds::core::DDScObjectDelegate::extract_strong_ref(p.delegate()->get_ddsc_entity());
+                if (found.get() != expected) {
+                    mismatches++;
+                }
+            }
+            for (dds::pub::Publisher& p : publishers) {
+                p.close();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(mismatches.load(), 0u);
+}
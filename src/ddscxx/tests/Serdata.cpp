@@ -9,6 +9,7 @@
 // SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
 
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "dds/dds.hpp"
 #include "Serialization.hpp"
@@ -16,6 +17,42 @@
 
 using namespace org::eclipse::cyclonedds::core::cdr;
 
+namespace org { namespace eclipse { namespace cyclonedds { namespace topic {
+template <> constexpr bool TopicTraits<Keyhash::DeferredKey>::deferDeserialization() { return true; }
+template <> constexpr bool TopicTraits<Keyhash::DeferredNoKey>::deferDeserialization() { return true; }
+template <> constexpr bool TopicTraits<Keyhash::DeferredBounded>::deferDeserialization() { return true; }
+} } } }
+
+/**
+ * Sertype of T, XCDR1, for the lifetime of the object. It is freed by hand, as the
+ * sertype_free function cannot be called with the C type being referenced nowhere.
+ */
+template<typename T>
+class SerType
+{
+public:
+    SerType() : m_st(org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1))
+    {
+    }
+
+    ~SerType()
+    {
+        dds_free(m_st->type_name);
+        delete static_cast<ddscxx_sertype<T, xcdr_v1_stream>*>(m_st);
+    }
+
+    SerType(const SerType&) = delete;
+    SerType& operator=(const SerType&) = delete;
+
+    ddsi_sertype *get() const
+    {
+        return m_st;
+    }
+
+private:
+    ddsi_sertype *m_st;
+};
+
 /**
  * Fixture for the tests
  */
@@ -243,8 +280,8 @@ using kh_t = std::array<unsigned char, 16>;
 template<typename T>
 static void test_keyhash(const T& sample, const kh_t& expected, const kh_t& expected_md5)
 {
-    auto st = org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1);
-    auto sd = serdata_from_sample<T, org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>(st, SDK_DATA, &sample);
+    const SerType<T> st;
+    auto sd = serdata_from_sample<T, org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>(st.get(), SDK_DATA, &sample);
     ASSERT_GT(sd->hash, static_cast<uint32_t>(0));
     struct ddsi_keyhash khraw, khraw_md5;
     serdata_get_keyhash<T>(sd, &khraw, false);
@@ -255,9 +292,6 @@ static void test_keyhash(const T& sample, const kh_t& expected, const kh_t& expe
     ASSERT_EQ(kh, expected);
     ASSERT_EQ(kh_md5, expected_md5);
     delete static_cast<ddscxx_serdata<T> *>(sd);
-    //hacky and ugly, but we cannot call the sertype_free function, as the C type is referenced nowhere
-    dds_free(st->type_name);
-    delete static_cast<ddscxx_sertype<T,org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>*>(st);
 }
 
 TEST_F(Serdata, keyhash_nokey)
@@ -300,6 +334,19 @@ TEST_F(Serdata, keyhash_stringkey)
     test_keyhash<T>(v, kh, kh_md5);
 }
 
+TEST_F(Serdata, keyhash_longstringkey)
+{
+    // perl -e 'print pack("N/Z*","Ick sie boven uut mijnen throne " x 10)' | md5 | sed -e 's/\(..\)/0x\1,/g' -e 's/,$//'
+    using T = Keyhash::StringKey;
+    std::string s;
+    for (size_t i = 0; i < 10; i++)
+        s += "Ick sie boven uut mijnen throne ";
+    const T v{s,0xabcdef01};
+    const kh_t kh{0xe9,0x42,0x7b,0x1a,0x3e,0x5c,0x1b,0xa1,0x7f,0x8a,0x2b,0xe6,0xb6,0xe9,0x83,0x2d};
+    const kh_t kh_md5 = kh;
+    test_keyhash<T>(v, kh, kh_md5);
+}
+
 TEST_F(Serdata, keyhash_bstringkey)
 {
     // perl -e '$v=pack("N/Z*x@16","Elckerlijc");print $v' | md5 | sed -e 's/\(..\)/0x\1,/g' -e 's/,$//'
@@ -309,3 +356,213 @@ TEST_F(Serdata, keyhash_bstringkey)
     const kh_t kh_md5{0x39, 0x59, 0x90, 0xf2, 0x0f, 0xd2, 0x53, 0x5a, 0x54, 0x07, 0xec, 0xa5, 0x65, 0xcc, 0xd2, 0xd7};
     test_keyhash<T>(v, kh, kh_md5);
 }
+
+template<typename T>
+static void test_deferred(const T& sample)
+{
+    const SerType<T> st;
+    auto sd_src = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>(st.get(), SDK_DATA, &sample));
+    ASSERT_NE(sd_src, nullptr);
+
+    ddsrt_iovec_t iov;
+    iov.iov_base = sd_src->data();
+    iov.iov_len = static_cast<ddsrt_iov_len_t>(sd_src->size());
+    auto sd = static_cast<ddscxx_serdata<T> *>(serdata_from_ser_iov<T>(st.get(), SDK_DATA, 1, &iov, sd_src->size()));
+    ASSERT_NE(sd, nullptr);
+
+    ASSERT_EQ(sd->hash, sd_src->hash);
+    ASSERT_EQ(0, memcmp(sd->key().value, sd_src->key().value, 16));
+    ASSERT_EQ(sd->key_md5_hashed(), sd_src->key_md5_hashed());
+
+    //converting it for a filter does not keep the deserialized sample in the serdata
+    T converted;
+    ASSERT_TRUE(serdata_to_sample<T>(sd, &converted, nullptr, nullptr));
+    ASSERT_EQ(converted, sample);
+    ASSERT_FALSE(sd->hasT());
+
+    auto t = sd->getT();
+    ASSERT_NE(t, nullptr);
+    ASSERT_EQ(*t, sample);
+
+    delete sd;
+    delete sd_src;
+}
+
+/*
+ * Checking that samples of which the deserialization is deferred get the same key
+ * and hash as when they were created from a sample, and are not kept deserialized
+ * when ddsc converts them to evaluate a filter.
+ */
+TEST_F(Serdata, deferred_deserialization)
+{
+    test_deferred(Keyhash::DeferredKey{"Ick sie boven uut mijnen throne",0xabcdef01});
+    test_deferred(Keyhash::DeferredNoKey{0xabcdef01});
+}
+
+/*
+ * Checking that only the key members of samples of which the deserialization is deferred
+ * are read when deriving their key, a sample with a sequence exceeding its bound still
+ * gets its key but fails to deserialize when it is accessed, and is delivered as an
+ * invalid sample when it is taken.
+ */
+TEST_F(Serdata, deferred_deserialization_key_only)
+{
+    using T = Keyhash::DeferredBounded;
+    using U = Keyhash::DeferredUnbounded;
+    const T exp{"Ick sie boven uut mijnen throne",{1,2}};
+    const U too_long{"Ick sie boven uut mijnen throne",{1,2,3}};
+    const SerType<T> st;
+    const SerType<U> st_u;
+
+    auto sd_exp = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &exp));
+    ASSERT_NE(sd_exp, nullptr);
+    auto sd_src = static_cast<ddscxx_serdata<U> *>(serdata_from_sample<U, xcdr_v1_stream>(st_u.get(), SDK_DATA, &too_long));
+    ASSERT_NE(sd_src, nullptr);
+
+    ddsrt_iovec_t iov;
+    iov.iov_base = sd_src->data();
+    iov.iov_len = static_cast<ddsrt_iov_len_t>(sd_src->size());
+    auto sd = static_cast<ddscxx_serdata<T> *>(serdata_from_ser_iov<T>(st.get(), SDK_DATA, 1, &iov, sd_src->size()));
+    ASSERT_NE(sd, nullptr);
+
+    ASSERT_EQ(sd->hash, sd_exp->hash);
+    ASSERT_EQ(0, memcmp(sd->key().value, sd_exp->key().value, 16));
+    ASSERT_EQ(sd->getT(), nullptr);
+
+    //as it is no longer available from the reader, it is delivered as an invalid sample
+    std::vector<dds::sub::Sample<T> > samples(1);
+    auto it = samples.begin();
+    dds::sub::detail::SamplesFWInteratorHolder<T, decltype(it)> holder(it);
+    dds_sample_info_t si;
+    memset(&si, 0, sizeof(si));
+    si.valid_data = true;
+    holder.append_sample(sd, &si);
+    holder.complete();
+    ASSERT_EQ(holder.get_length(), 1u);
+    ASSERT_FALSE(samples[0].info().valid());
+
+    delete sd;
+    delete sd_src;
+    delete sd_exp;
+}
+
+/*
+ * Checking that released serdata are reused, and are correctly reinitialized.
+ */
+TEST_F(Serdata, recycling)
+{
+    using T = Keyhash::StringKey;
+    const T v1{"Ick sie boven uut mijnen throne",0xabcdef01},
+            v2{"Elckerlijc",0x12345678};
+    const SerType<T> st;
+
+    auto sd1 = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v1));
+    ASSERT_NE(sd1, nullptr);
+    const uint32_t hash1 = sd1->hash;
+    serdata_free<T>(sd1);
+
+    auto sd2 = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v2));
+    ASSERT_EQ(sd2, sd1);
+    ASSERT_NE(sd2->hash, hash1);
+    ASSERT_EQ(sd2->kind, SDK_DATA);
+    ASSERT_EQ(*sd2->getT(), v2);
+
+    T out;
+    ASSERT_TRUE(deserialize_sample_from_buffer(sd2->data(), sd2->size(), out));
+    ASSERT_EQ(out, v2);
+    serdata_free<T>(sd2);
+}
+
+/*
+ * Checking that serdata released on another thread are reused by the thread creating
+ * the next ones, as received samples are released by the application.
+ */
+TEST_F(Serdata, recycling_across_threads)
+{
+    using T = Keyhash::StringKey;
+    const T v{"Elckerlijc",0x12345678};
+    const SerType<T> st;
+
+    auto sd1 = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v));
+    ASSERT_NE(sd1, nullptr);
+    std::thread releaser([sd1]() { serdata_free<T>(sd1); });
+    releaser.join();
+
+    auto sd2 = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v));
+    ASSERT_EQ(sd2, sd1);
+    ASSERT_EQ(*sd2->getT(), v);
+    serdata_free<T>(sd2);
+}
+
+/*
+ * Checking that small payloads are stored in the serdata itself.
+ */
+TEST_F(Serdata, inline_payload)
+{
+    using T = Keyhash::StringKey;
+    const T small{"Elckerlijc",0x12345678},
+            large{std::string(2*DDSCXX_SERDATA_INLINE_SIZE, 'x'),0x12345678};
+    const SerType<T> st;
+
+    for (const auto &v: {small, large, small}) {
+        auto sd = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v));
+        ASSERT_NE(sd, nullptr);
+        const auto obj_start = reinterpret_cast<const unsigned char*>(sd),
+                   obj_end = obj_start + sizeof(*sd),
+                   data = static_cast<const unsigned char*>(sd->data());
+        ASSERT_EQ(data >= obj_start && data < obj_end, sd->size() <= DDSCXX_SERDATA_INLINE_SIZE);
+
+        T out;
+        ASSERT_TRUE(deserialize_sample_from_buffer(sd->data(), sd->size(), out));
+        ASSERT_EQ(out, v);
+        serdata_free<T>(sd);
+    }
+}
+
+template<typename T>
+static void test_single_pass(const std::vector<T>& samples)
+{
+    const SerType<T> st;
+
+    for (const auto &v: samples) {
+        auto sd = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st.get(), SDK_DATA, &v));
+        ASSERT_NE(sd, nullptr);
+
+        //the same as first determining the size, then serializing
+        size_t sz = 0;
+        ASSERT_TRUE((get_serialized_size<T, xcdr_v1_stream, key_mode::not_key>(v, sz)));
+        sz += DDSI_RTPS_HEADER_SIZE;
+        std::vector<unsigned char> exp(sz + 3, 0x0);
+        ASSERT_TRUE((serialize_into<T, xcdr_v1_stream>(exp.data(), sz, v, key_mode::not_key)));
+        exp.resize((sz + 3) / 4 * 4);
+        ASSERT_EQ(std::vector<unsigned char>(static_cast<unsigned char*>(sd->data()), static_cast<unsigned char*>(sd->data()) + sd->size()), exp);
+
+        //no buffer is kept for inline payloads, nor one much larger than the payload
+        if (sd->size() <= DDSCXX_SERDATA_INLINE_SIZE)
+            ASSERT_EQ(sd->capacity(), 0u);
+        else
+            ASSERT_LT(sd->capacity(), 2 * sd->size());
+        serdata_free<T>(sd);
+    }
+}
+
+/*
+ * Checking that samples are serialized in a single pass, into a scratch buffer or
+ * after sizing them when they do not fit, the same as when sized separately.
+ */
+TEST_F(Serdata, single_pass)
+{
+    test_single_pass<Keyhash::StringKey>({
+        {"Elckerlijc",0x12345678},
+        {std::string(2*DDSCXX_SERDATA_INLINE_SIZE, 'x'),0x12345678},
+        {"Ick sie boven uut mijnen throne",0xabcdef01},
+        {std::string(4*DDSCXX_SERDATA_CACHE_MAX_BUFFER, 'y'),0xabcdef01},
+        {std::string(DDSCXX_SERDATA_INLINE_SIZE, 'z'),0xabcdef01}});
+    test_single_pass<Keyhash::BStringKey>({
+        {"Elckerlijc",0x12345678},
+        {"",0xabcdef01}});
+    test_single_pass<Keyhash::LargeBound>({
+        {0x12345678,std::string(200, 'x')},
+        {0x12345678,""},
+        {0xabcdef01,std::string(3000, 'y')}});
+}
@@ -456,3 +456,51 @@ TEST_F(Topic, data_representation)
   test_representations<traits_models::td_3>(extensibility::ext_final, 0xFFFFFFFE);
   test_representations<traits_models::s_3>(extensibility::ext_final, DDS_DATA_REPRESENTATION_FLAG_XCDR2);
 }
+
+TEST_F(Topic, content_filtered_expression)
+{
+    this->CreateTopic();
+
+    std::vector<std::string> params(1, "3");
+    dds::topic::ContentFilteredTopic<Space::Type1> cftopic(this->topic, "cftopic",
+        dds::topic::Filter("long_2 > %0 AND long_3 BETWEEN 10 AND 20", params));
+    ASSERT_EQ(cftopic.filter_expression(), "long_2 > %0 AND long_3 BETWEEN 10 AND 20");
+
+    dds::pub::Publisher publisher(this->participant);
+    dds::sub::Subscriber subscriber(this->participant);
+    dds::pub::DataWriter<Space::Type1> writer(publisher, this->topic);
+    dds::sub::DataReader<Space::Type1> reader(subscriber, cftopic);
+
+    writer << Space::Type1(1, 3, 15) << Space::Type1(2, 4, 15) << Space::Type1(3, 4, 21);
+    dds::sub::LoanedSamples<Space::Type1> samples = reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data(), Space::Type1(2, 4, 15));
+
+    /* Parameters are replaced without recompiling the expression. */
+    params[0] = "1";
+    cftopic.filter_parameters(params.begin(), params.end());
+    ASSERT_EQ(cftopic.filter_parameters(), dds::core::StringSeq(params));
+
+    writer << Space::Type1(4, 2, 10) << Space::Type1(5, 1, 10);
+    samples = reader.take();
+    ASSERT_EQ(samples.length(), 1u);
+    ASSERT_EQ(samples.begin()->data(), Space::Type1(4, 2, 10));
+
+    params[0] = "abc";
+    ASSERT_THROW(cftopic.filter_parameters(params.begin(), params.end()), dds::core::InvalidArgumentError);
+    ASSERT_EQ(cftopic.filter_parameters()[0], "1");
+}
+
+TEST_F(Topic, content_filtered_invalid_expression)
+{
+    this->CreateTopic();
+
+    ASSERT_THROW(dds::topic::ContentFilteredTopic<Space::Type1>(this->topic, "cftopic",
+                     dds::topic::Filter("long_4 = 1")), dds::core::InvalidArgumentError);
+    ASSERT_THROW(dds::topic::ContentFilteredTopic<Space::Type1>(this->topic, "cftopic",
+                     dds::topic::Filter("long_1 = 'a'")), dds::core::InvalidArgumentError);
+    ASSERT_THROW(dds::topic::ContentFilteredTopic<Space::Type1>(this->topic, "cftopic",
+                     dds::topic::Filter("long_1 = %0")), dds::core::InvalidArgumentError);
+    ASSERT_THROW(dds::topic::ContentFilteredTopic<Space::Type1>(this->topic, "cftopic",
+                     dds::topic::Filter("long_1 = 1 AND")), dds::core::InvalidArgumentError);
+}
@@ -586,6 +586,50 @@ TEST_F(WaitSet, guard_trigger_before_wait)
     waitSet -= guard;
 }
 
+/**
+ * Test waiting into a fixed array of condition delegates
+ */
+TEST_F(WaitSet, wait_fixed_array)
+{
+    org::eclipse::cyclonedds::core::cond::ConditionDelegate *triggered[2] = { nullptr, nullptr };
+    dds::core::Duration waitTimeout = dds::core::Duration::from_millisecs(500);
+    dds::core::cond::GuardCondition guard2;
+    size_t n = 0;
+
+    waitSet = dds::core::cond::WaitSet();
+    waitSet += guard;
+    waitSet += guard2;
+
+    // Nothing triggered
+    ASSERT_THROW({
+        waitSet->wait(triggered, 2, dds::core::Duration::from_millisecs(100));
+    }, dds::core::TimeoutError);
+
+    guard.trigger_value(true);
+    guard2.trigger_value(true);
+
+    // Only as many as fit are returned, the others remain triggered
+    ASSERT_NO_THROW({
+        n = waitSet->wait(triggered, 1, waitTimeout);
+    });
+    ASSERT_EQ(n, 1u);
+    ASSERT_TRUE(triggered[0] == guard.delegate().get() || triggered[0] == guard2.delegate().get());
+
+    ASSERT_NO_THROW({
+        n = waitSet->wait(triggered, 2, waitTimeout);
+    });
+    ASSERT_EQ(n, 2u);
+    ASSERT_NE(triggered[0], triggered[1]);
+    ASSERT_TRUE(triggered[0] == guard.delegate().get() || triggered[0] == guard2.delegate().get());
+    ASSERT_TRUE(triggered[1] == guard.delegate().get() || triggered[1] == guard2.delegate().get());
+
+    // Clean-up
+    guard.trigger_value(false);
+    guard2.trigger_value(false);
+    waitSet -= guard;
+    waitSet -= guard2;
+}
+
 /**
  * Test adding multiple conditions to WaitSet
  */
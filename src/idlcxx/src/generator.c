@@ -579,6 +579,115 @@ bool is_selfcontained(const void *node)
   return true;
 }
 
+static bool pod_base_type(const void *node, uint32_t *size)
+{
+  switch (idl_type(node)) {
+    case IDL_CHAR:
+    case IDL_BOOL:
+    case IDL_INT8:
+    case IDL_UINT8:
+    case IDL_OCTET:
+      *size = 1;
+      break;
+    case IDL_SHORT:
+    case IDL_INT16:
+    case IDL_USHORT:
+    case IDL_UINT16:
+      *size = 2;
+      break;
+    case IDL_LONG:
+    case IDL_INT32:
+    case IDL_ULONG:
+    case IDL_UINT32:
+    case IDL_FLOAT:
+      *size = 4;
+      break;
+    case IDL_LLONG:
+    case IDL_INT64:
+    case IDL_ULLONG:
+    case IDL_UINT64:
+    case IDL_DOUBLE:
+      *size = 8;
+      break;
+    default:
+      return false;
+  }
+
+  return true;
+}
+
+static bool pod_array(const idl_declarator_t *declarator, uint32_t *size)
+{
+  for (const idl_const_expr_t *ce = declarator->const_expr; ce; ce = idl_next(ce))
+    *size *= ((const idl_literal_t *)ce)->value.uint32;
+
+  return *size != 0;
+}
+
+static bool pod_struct(const idl_struct_t *str, uint32_t *size, uint32_t *alignment)
+{
+  uint32_t offset = 0, max_alignment = 1;
+
+  if (str->inherit_spec || get_extensibility(str) != IDL_FINAL)
+    return false;
+
+  const idl_member_t *mem = NULL;
+  IDL_FOREACH(mem, str->members) {
+    uint32_t mem_size = 0, mem_alignment = 0;
+    if (is_optional(mem)
+     || is_external(mem)
+     || !get_pod_layout(mem->type_spec, &mem_size, &mem_alignment))
+      return false;
+
+    const idl_declarator_t *decl = NULL;
+    IDL_FOREACH(decl, mem->declarators) {
+      uint32_t decl_size = mem_size;
+      if (idl_is_array(decl) && !pod_array(decl, &decl_size))
+        return false;
+      if (offset % mem_alignment)  //padding would be inserted before this member
+        return false;
+      offset += decl_size;
+    }
+
+    if (mem_alignment > max_alignment)
+      max_alignment = mem_alignment;
+  }
+
+  if (offset == 0 || offset % max_alignment)  //padding would be inserted after the last member
+    return false;
+
+  *size = offset;
+  *alignment = max_alignment;
+  return true;
+}
+
+/* determines whether the memory layout of a type is identical to its CDR
+   representation, which is the case for final structs without padding which
+   only contain primitives, arrays of primitives and other such structs */
+bool get_pod_layout(const void *node, uint32_t *size, uint32_t *alignment)
+{
+  if (idl_is_forward(node)) {
+    return get_pod_layout(idl_type_spec(node), size, alignment);
+  } else if (idl_is_typedef(node)) {
+    return get_pod_layout(((const idl_typedef_t*)node)->declarators, size, alignment);
+  } else if (idl_is_declarator(node)) {
+    const idl_node_t *parent = ((const idl_node_t*)node)->parent;
+    assert (idl_is_typedef(parent));
+    if (!get_pod_layout(((const idl_typedef_t*)parent)->type_spec, size, alignment))
+      return false;
+    return !idl_is_array(node) || pod_array(node, size);
+  } else if (idl_is_struct(node)) {
+    return pod_struct(node, size, alignment);
+  } else if (idl_is_base_type(node)) {
+    if (!pod_base_type(node, size))
+      return false;
+    *alignment = *size;
+    return true;
+  }
+
+  return false;
+}
+
 idl_extensibility_t
 get_extensibility(const void *node)
 {
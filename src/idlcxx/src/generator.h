@@ -88,6 +88,9 @@ bool is_nested(
 bool is_selfcontained(
   const void *node);
 
+bool get_pod_layout(
+  const void *node, uint32_t *size, uint32_t *alignment);
+
 idl_extensibility_t get_extensibility(
   const void *node);
 
@@ -128,6 +128,8 @@ struct streams {
   idl_buffer_t move;
   idl_buffer_t max;
   idl_buffer_t props;
+  bool straight_line;
+  bool straight_line_started;
 };
 
 static void setup_streams(struct streams* str, struct generator* gen)
@@ -431,6 +433,62 @@ unroll_sequence(const idl_pstate_t* pstate,
   const char* read_accessor,
   instance_location_t loc);
 
+static bool
+is_pod_struct(const idl_type_spec_t *type_spec)
+{
+  uint32_t size = 0, alignment = 0;
+  type_spec = idl_strip(type_spec, IDL_STRIP_FORWARD);
+  return idl_is_struct(type_spec) && get_pod_layout(type_spec, &size, &alignment);
+}
+
+static idl_retcode_t
+pod_copy_open(
+  struct streams* streams,
+  const idl_type_spec_t *type_spec,
+  const char *accessor,
+  const char *read_accessor,
+  size_t depth)
+{
+  static const char *afmt =
+    "      if (streamer.direct_copy_possible(get_pod_layout_alignment<%1$s>())) {\n"
+    "        if (!{T}_pod(streamer, %2$s, %3$s.size()))\n"
+    "          return false;\n"
+    "      } else {\n";
+  static const char *sfmt =
+    "      if (se_%3$u > 0 &&\n"
+    "          streamer.direct_copy_possible(get_pod_layout_alignment<%1$s>())) {\n"
+    "        if (!{T}_pod(streamer, %2$s, se_%3$u))\n"
+    "          return false;\n"
+    "      } else {\n";
+
+  //arrays are copied from their first element, sequences also, when they are not empty
+  char *type = NULL, *first = NULL, *read_first = NULL, *temp = NULL;
+  if (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, idl_strip(type_spec, IDL_STRIP_FORWARD), streams->generator) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  idl_retcode_t ret = IDL_RETCODE_NO_MEMORY;
+  if (idl_asprintf(&first, "%s[0]", accessor) >= 0
+   && idl_asprintf(&read_first, "%s[0]", read_accessor) >= 0
+   && idl_asprintf(&temp, "%s()", type) >= 0) {
+    if (depth) {
+      if (!multi_putf(streams, WRITE, sfmt, type, first, (uint32_t)depth)
+       && !multi_putf(streams, READ, sfmt, type, read_first, (uint32_t)depth)
+       && !multi_putf(streams, (MOVE | MAX), sfmt, type, temp, (uint32_t)depth))
+        ret = IDL_RETCODE_OK;
+    } else {
+      if (!multi_putf(streams, WRITE, afmt, type, first, accessor)
+       && !multi_putf(streams, READ, afmt, type, read_first, read_accessor)
+       && !multi_putf(streams, (MOVE | MAX), afmt, type, temp, accessor))
+        ret = IDL_RETCODE_OK;
+    }
+  }
+
+  free(first);
+  free(read_first);
+  free(temp);
+  return ret;
+}
+
 static idl_retcode_t
 sequence_writes(const idl_pstate_t* pstate,
   struct streams* streams,
@@ -464,6 +522,11 @@ sequence_writes(const idl_pstate_t* pstate,
     return IDL_RETCODE_OK;
   }
 
+  //sequences of structs whose memory layout is identical to their CDR representation are copied directly
+  bool pod_copy = is_pod_struct(type_spec);
+  if (pod_copy && pod_copy_open(streams, type_spec, accessor, read_accessor, depth))
+    return IDL_RETCODE_NO_MEMORY;
+
   static const char* fmt = "      for (uint32_t i_%1$u = 0; i_%1$u < se_%1$u; i_%1$u++) {\n";
   if (multi_putf(streams, ALL, fmt, depth, ""))
     return IDL_RETCODE_NO_MEMORY;
@@ -492,6 +555,9 @@ sequence_writes(const idl_pstate_t* pstate,
   if (multi_putf(streams, ALL, cfmt, depth))
     return IDL_RETCODE_NO_MEMORY;
 
+  if (pod_copy && multi_putf(streams, ALL, "      }\n"))
+    return IDL_RETCODE_NO_MEMORY;
+
   return IDL_RETCODE_OK;
 }
 
@@ -615,7 +681,7 @@ process_entity(
 
   //unroll arrays
   uint32_t n_arr = 0;
-  bool batch_copy = false;
+  bool batch_copy = false, pod_copy = false;
   if (idl_is_array(declarator)) {
     const idl_literal_t* lit = (const idl_literal_t*)declarator->const_expr;
     if (multi_putf(streams, ALL, consec_start_fmt, idl_is_base_type(root_type_spec) ? "true" : "false"))
@@ -629,6 +695,16 @@ process_entity(
         break;
       }
 
+      //the innermost arrays of structs whose memory layout is identical to their CDR representation are copied directly
+      if (!next && is_pod_struct(type_spec)) {
+        char *arr_accessor = NULL;
+        if (n_arr && IDL_PRINTA(&arr_accessor, get_array_accessor, declarator, &n_arr) < 0)
+          return IDL_RETCODE_NO_MEMORY;
+        if (pod_copy_open(streams, type_spec, n_arr ? arr_accessor : accessor, n_arr ? arr_accessor : read_accessor, 0))
+          return IDL_RETCODE_NO_MEMORY;
+        pod_copy = true;
+      }
+
       if (n_arr == 0) {
         if (multi_putf(streams, CONST, array_iterate1, n_arr+1, accessor) ||
             multi_putf(streams, READ, array_iterate1, n_arr+1, read_accessor))  //write iteration over initial array
@@ -663,6 +739,11 @@ process_entity(
   while (n_arr) {
     if (multi_putf(streams, ALL, array_close, n_arr--))
       return IDL_RETCODE_NO_MEMORY;
+    if (pod_copy) {
+      if (multi_putf(streams, ALL, "      }\n"))
+        return IDL_RETCODE_NO_MEMORY;
+      pod_copy = false;
+    }
   }
 
   if (idl_is_array(declarator))
@@ -829,12 +910,29 @@ add_member_finish(
       return IDL_RETCODE_NO_MEMORY;
   }
 
-  if (multi_putf(streams, ALL, "      break;\n"))
+  if (!streams->straight_line
+   && multi_putf(streams, ALL, "      break;\n"))
     return IDL_RETCODE_NO_MEMORY;
 
   return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t
+add_straight_line_member(
+  struct streams *streams)
+{
+  static const char *first_fmt =
+    "      auto prop = props->first_member;\n";
+  static const char *next_fmt =
+    "      prop = prop->next_on_level;\n";
+
+  if (multi_putf(streams, ALL, streams->straight_line_started ? next_fmt : first_fmt))
+    return IDL_RETCODE_NO_MEMORY;
+
+  streams->straight_line_started = true;
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 process_member(
   const idl_pstate_t* pstate,
@@ -856,8 +954,14 @@ process_member(
     static const char *fmt =
       "      case %"PRIu32":\n";
 
-    if (multi_putf(streams, ALL, fmt, declarator->id.value)
-     || add_member_start(declarator, streams))
+    if (streams->straight_line) {
+      if (add_straight_line_member(streams))
+        return IDL_RETCODE_NO_MEMORY;
+    } else if (multi_putf(streams, ALL, fmt, declarator->id.value)) {
+      return IDL_RETCODE_NO_MEMORY;
+    }
+
+    if (add_member_start(declarator, streams))
       return IDL_RETCODE_NO_MEMORY;
 
     instance_location_t loc = {.parent = "instance"};
@@ -867,7 +971,8 @@ process_member(
       loc.type |= OPTIONAL;
 
     // only use the @key annotations when you do not use the keylist
-    if (!(pstate->config.flags & IDL_FLAG_KEYLIST) &&
+    if (!streams->straight_line &&
+        !(pstate->config.flags & IDL_FLAG_KEYLIST) &&
         mem->key.value &&
         putf(&streams->props, "  keylist.add_key_endpoint(std::list<uint32_t>{%1$"PRIu32"});\n", declarator->id.value))
       return IDL_RETCODE_NO_MEMORY;
@@ -1058,6 +1163,27 @@ process_keylist(
   return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t
+print_pod_layout(struct streams *streams, const idl_node_t *node, const char *name)
+{
+  static const char *lfmt =
+    "template<>\n"
+    "constexpr size_t get_pod_layout_alignment<%1$s>() { return sizeof(%1$s) == %2$"PRIu32" ? %3$"PRIu32" : 0; }\n\n";
+  static const char *fmt =
+    "  if (streamer.direct_copy_possible(get_pod_layout_alignment<%1$s>()))\n"
+    "    return {T}_pod(streamer, instance);\n";
+
+  uint32_t size = 0, alignment = 0;
+  if (!idl_is_struct(node) || !get_pod_layout(node, &size, &alignment))
+    return IDL_RETCODE_OK;
+
+  if (idl_fprintf(streams->generator->header.handle, lfmt, name, size, alignment) < 0
+   || multi_putf(streams, ALL, fmt, name))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 print_constructed_type_open(struct streams *streams, const idl_node_t *node)
 {
@@ -1108,6 +1234,7 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
   if (multi_putf(streams, ALL, fmt, name)
    || putf(&streams->props, pfmt1, name, pfmt2)
    || idl_fprintf(streams->generator->header.handle, pfmt1, name, ";\n\n") < 0
+   || print_pod_layout(streams, node, name)
    || multi_putf(streams, ALL, sfmt)
    || putf(&streams->props, "  props.push_back(entity_properties_t(0, 0, false, bit_bound::bb_unset, extensibility::%1$s));  //root\n", ext))
     return IDL_RETCODE_NO_MEMORY;
@@ -1129,6 +1256,51 @@ print_switchbox_open(struct streams *streams)
   return IDL_RETCODE_OK;
 }
 
+static bool
+has_fixed_layout(const idl_struct_t *_struct)
+{
+  const idl_struct_t *base = _struct;
+  while (base) {
+    if (get_extensibility(base) != IDL_FINAL)
+      return false;
+
+    const idl_member_t *member = NULL;
+    IDL_FOREACH(member, base->members) {
+      if (is_optional(member))
+        return false;
+    }
+
+    base = base->inherit_spec ? (const idl_struct_t *)(base->inherit_spec->base) : NULL;
+  }
+
+  return true;
+}
+
+static idl_retcode_t
+print_straight_line_open(struct streams *streams)
+{
+  static const char *fmt =
+    "  if (!streamer.is_key()) {\n";
+
+  if (multi_putf(streams, ALL, fmt))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+print_straight_line_close(struct streams *streams)
+{
+  static const char *fmt =
+    "    return streamer.finish_struct(*props, member_ids);\n"
+    "  }\n";
+
+  if (multi_putf(streams, ALL, fmt))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 print_constructed_type_close(
   struct streams *streams,
@@ -1202,7 +1374,7 @@ return IDL_RETCODE_OK;
 }
 
 static idl_retcode_t
-process_struct_contents(
+process_struct_members(
   const idl_pstate_t* pstate,
   const bool revisit,
   const idl_path_t* path,
@@ -1210,10 +1382,7 @@ process_struct_contents(
   struct streams *streams)
 {
   idl_retcode_t ret = IDL_RETCODE_OK;
-  bool keylist_flag = (pstate->config.flags & IDL_FLAG_KEYLIST);
-
-  if (generate_struct_properties(_struct, streams))
-    return IDL_RETCODE_NO_MEMORY;
+  bool keylist_flag = (pstate->config.flags & IDL_FLAG_KEYLIST) && !streams->straight_line;
 
   size_t to_unroll = 1;
   const idl_struct_t *base = _struct;
@@ -1243,6 +1412,395 @@ process_struct_contents(
   return ret;
 }
 
+static idl_retcode_t
+process_struct_contents(
+  const idl_pstate_t* pstate,
+  const bool revisit,
+  const idl_path_t* path,
+  const idl_struct_t *_struct,
+  struct streams *streams)
+{
+  if (generate_struct_properties(_struct, streams))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return process_struct_members(pstate, revisit, path, _struct, streams);
+}
+
+/* final structs without optional members always have all their members
+   streamed in declaration order when not in key mode, so for these the
+   members are streamed directly, without the switchbox over the entity
+   properties, which is only used for key mode */
+static idl_retcode_t
+process_struct_straight_line(
+  const idl_pstate_t* pstate,
+  const bool revisit,
+  const idl_path_t* path,
+  const idl_struct_t *_struct,
+  struct streams *streams)
+{
+  idl_retcode_t ret = IDL_RETCODE_OK;
+
+  if (!has_fixed_layout(_struct))
+    return IDL_RETCODE_OK;
+
+  streams->straight_line = true;
+  streams->straight_line_started = false;
+  if ((ret = print_straight_line_open(streams))
+   || (ret = process_struct_members(pstate, revisit, path, _struct, streams))
+   || (ret = print_straight_line_close(streams)))
+    return ret;
+  streams->straight_line = false;
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+print_view_members(
+  idl_buffer_t *types,
+  idl_buffer_t *accessors,
+  const idl_struct_t *_struct,
+  struct generator *gen,
+  uint32_t *index,
+  bool *viewable);
+
+/* appends the view member descriptor of declarator to types, if types is not NULL,
+   viewable is set to false if the member cannot be accessed in its CDR representation */
+static idl_retcode_t
+print_view_member(
+  idl_buffer_t *types,
+  const idl_declarator_t *declarator,
+  const idl_type_spec_t *type_spec,
+  struct generator *gen,
+  bool *viewable)
+{
+  uint32_t size = 0, alignment = 0, index = 0;
+  char *type = NULL;
+  const idl_type_spec_t *ts = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+
+  if (idl_is_array(ts)) {
+    *viewable = false;
+  } else if (idl_is_array(declarator)) {
+    uint32_t n = 1;
+    for (const idl_const_expr_t *ce = declarator->const_expr; ce; ce = idl_next(ce))
+      n *= ((const idl_literal_t *)ce)->value.uint32;
+    if (!idl_is_base_type(ts) || !get_pod_layout(ts, &size, &alignment))
+      *viewable = false;
+    else if (types && (IDL_PRINTA(&type, get_cpp11_type, ts, gen) < 0
+                    || putf(types, ", cdr_array<%s, %"PRIu32">", type, n)))
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_base_type(ts)) {
+    if (!get_pod_layout(ts, &size, &alignment))
+      *viewable = false;
+    else if (types && (IDL_PRINTA(&type, get_cpp11_type, ts, gen) < 0
+                    || putf(types, ", %s", type)))
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_enum(ts)) {
+    const idl_enum_t *_enum = ts;
+    if (_enum->bit_bound.annotation && _enum->bit_bound.value > 32)
+      *viewable = false;
+    else if (types && (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, ts, gen) < 0
+                    || putf(types, ", %s", type)))
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_string(ts)) {
+    if (types && putf(types, ", cdr_string"))
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_sequence(ts)) {
+    const idl_type_spec_t *elem = idl_strip(((const idl_sequence_t *)ts)->type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+    if (idl_is_array(elem) || !idl_is_base_type(elem) || !get_pod_layout(elem, &size, &alignment))
+      *viewable = false;
+    else if (types && (IDL_PRINTA(&type, get_cpp11_type, elem, gen) < 0
+                    || putf(types, ", cdr_sequence<%s>", type)))
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_struct(ts)) {
+    idl_retcode_t ret;
+    if ((ret = print_view_members(NULL, NULL, ts, gen, &index, viewable)))
+      return ret;
+    if (*viewable && types && (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, ts, gen) < 0
+                            || putf(types, ", view<%s>", type)))
+      return IDL_RETCODE_NO_MEMORY;
+  } else {
+    *viewable = false;
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+/* appends the member descriptors and accessors of the view of _struct, including
+   those of its base structs, viewable is set to false if any of the members cannot
+   be accessed in its CDR representation */
+static idl_retcode_t
+print_view_members(
+  idl_buffer_t *types,
+  idl_buffer_t *accessors,
+  const idl_struct_t *_struct,
+  struct generator *gen,
+  uint32_t *index,
+  bool *viewable)
+{
+  idl_retcode_t ret;
+
+  if (get_extensibility(_struct) == IDL_MUTABLE) {
+    *viewable = false;
+    return IDL_RETCODE_OK;
+  }
+
+  if (_struct->inherit_spec
+   && (ret = print_view_members(types, accessors, (const idl_struct_t *)_struct->inherit_spec->base, gen, index, viewable)))
+    return ret;
+
+  const idl_member_t *member = NULL;
+  IDL_FOREACH(member, _struct->members) {
+    if (!*viewable)
+      break;
+    if (is_optional(member)) {
+      *viewable = false;
+      break;
+    }
+
+    const idl_declarator_t *declarator = NULL;
+    IDL_FOREACH(declarator, member->declarators) {
+      if ((ret = print_view_member(types, declarator, member->type_spec, gen, viewable)))
+        return ret;
+      if (!*viewable)
+        break;
+      if (accessors && putf(accessors, "  view_base::member_t<%2$"PRIu32"> %1$s() const { return view_base::get<%2$"PRIu32">(); }\n", get_cpp11_name(declarator), *index))
+        return IDL_RETCODE_NO_MEMORY;
+      (*index)++;
+    }
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+/* appends the assignments of the key members of _struct, including those of its base
+   structs, from its view, keyable is set to false if a key member is not a primitive,
+   enum or string, as only those are loaded from the view */
+static idl_retcode_t
+print_view_keys(
+  idl_buffer_t *keys,
+  const idl_struct_t *_struct,
+  bool *keyable)
+{
+  idl_retcode_t ret;
+
+  if (_struct->inherit_spec
+   && (ret = print_view_keys(keys, (const idl_struct_t *)_struct->inherit_spec->base, keyable)))
+    return ret;
+
+  const idl_member_t *member = NULL;
+  IDL_FOREACH(member, _struct->members) {
+    if (!member->key.value)
+      continue;
+
+    const idl_type_spec_t *ts = idl_strip(member->type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+    const idl_declarator_t *declarator = NULL;
+    IDL_FOREACH(declarator, member->declarators) {
+      const char *name = get_cpp11_name(declarator);
+      if (idl_is_array(declarator) || !(idl_is_base_type(ts) || idl_is_enum(ts) || idl_is_string(ts))) {
+        *keyable = false;
+        return IDL_RETCODE_OK;
+      }
+      if (idl_is_string(ts)) {
+        if (putf(keys, "    {\n"
+                       "      cdr_string_view s = v.%1$s();\n"
+                       "      sample.%1$s().assign(s.data(), s.size());\n"
+                       "    }\n", name))
+          return IDL_RETCODE_NO_MEMORY;
+      } else if (putf(keys, "    sample.%1$s() = v.%1$s();\n", name)) {
+        return IDL_RETCODE_NO_MEMORY;
+      }
+    }
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+/* prints a read-only view for structs of which all members can be accessed
+   directly in their CDR representation, and the loading of their key members
+   from the view when these are all primitives, enums or strings */
+static idl_retcode_t
+print_view(const idl_pstate_t *pstate, struct streams *streams, const idl_struct_t *_struct, const char *fullname)
+{
+  static const char *fmt =
+    "template<>\n"
+    "class view<%1$s> : public cdr_view<extensibility::%2$s%3$s> {\n"
+    "public:\n"
+    "  typedef cdr_view<extensibility::%2$s%3$s> view_base;\n"
+    "  using view_base::view_base;\n"
+    "%4$s"
+    "};\n\n";
+  static const char *keys_fmt =
+    "template<>\n"
+    "struct view_keys<%1$s> {\n"
+    "  static void load(const view<%1$s> &v, %1$s &sample) {\n"
+    "%2$s"
+    "  }\n"
+    "};\n\n";
+
+  idl_retcode_t ret = IDL_RETCODE_OK;
+  idl_buffer_t types, accessors, keys;
+  uint32_t index = 0;
+  bool viewable = true;
+  /* with a keylist the @key annotations are not used */
+  bool keyable = !(pstate->config.flags & IDL_FLAG_KEYLIST);
+
+  memset(&types, 0, sizeof(types));
+  memset(&accessors, 0, sizeof(accessors));
+  memset(&keys, 0, sizeof(keys));
+
+  if ((ret = print_view_members(&types, &accessors, _struct, streams->generator, &index, &viewable)) == IDL_RETCODE_OK
+   && viewable
+   && idl_fprintf(streams->generator->header.handle, fmt, fullname,
+                  get_extensibility(_struct) == IDL_FINAL ? "ext_final" : "ext_appendable",
+                  types.data ? types.data : "", accessors.data ? accessors.data : "") < 0)
+    ret = IDL_RETCODE_NO_MEMORY;
+
+  if (ret == IDL_RETCODE_OK && viewable && keyable
+   && (ret = print_view_keys(&keys, _struct, &keyable)) == IDL_RETCODE_OK
+   && keyable && keys.data
+   && idl_fprintf(streams->generator->header.handle, keys_fmt, fullname, keys.data) < 0)
+    ret = IDL_RETCODE_NO_MEMORY;
+
+  if (types.data)
+    free(types.data);
+  if (accessors.data)
+    free(accessors.data);
+  if (keys.data)
+    free(keys.data);
+
+  return ret;
+}
+
+/* appends the lookup and the accessors of the members of _struct, including those of
+   its base structs, which can be referenced in filter expressions: primitives, enums,
+   strings and (members of) structs. key members can also be stored, keys counts them,
+   or is cleared when a key member cannot be stored */
+static idl_retcode_t
+print_filter_members(
+  idl_buffer_t *resolve,
+  idl_buffer_t *load,
+  idl_buffer_t *store,
+  const idl_struct_t *_struct,
+  const char *fullname,
+  struct generator *gen,
+  uint32_t *index,
+  uint32_t *keys,
+  bool *keyable)
+{
+  idl_retcode_t ret;
+
+  if (_struct->inherit_spec
+   && (ret = print_filter_members(resolve, load, store, (const idl_struct_t *)_struct->inherit_spec->base, fullname, gen, index, keys, keyable)))
+    return ret;
+
+  const idl_member_t *member = NULL;
+  IDL_FOREACH(member, _struct->members) {
+    const idl_type_spec_t *ts = idl_strip(member->type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+    const idl_declarator_t *declarator = NULL;
+    IDL_FOREACH(declarator, member->declarators) {
+      const char *name = get_cpp11_name(declarator);
+      char *type = NULL;
+      uint32_t i = (*index)++;
+      bool leaf = idl_is_base_type(ts) || idl_is_enum(ts) || idl_is_string(ts);
+
+      if (is_optional(member) || is_external(member) || idl_is_array(declarator) || idl_is_array(ts)) {
+        if (member->key.value)
+          *keyable = false;
+        continue;
+      }
+
+      if (leaf && member->key.value) {
+        (*keys)++;
+        if (putf(resolve, "    if (member == \"%1$s\")\n"
+                          "      return filter_resolve_leaf<decl_ref_type(std::declval<const %2$s&>().%3$s())>(%4$"PRIu32", next, field, true);\n",
+                 idl_identifier(declarator), fullname, name, i)
+         || putf(load, "      case %2$"PRIu32": return filter_load(sample.%1$s());\n", name, i)
+         || putf(store, "      case %2$"PRIu32": return filter_store(sample.%1$s(), value);\n", name, i))
+          return IDL_RETCODE_NO_MEMORY;
+      } else if (leaf) {
+        if (putf(resolve, "    if (member == \"%1$s\")\n"
+                          "      return filter_resolve_leaf<decl_ref_type(std::declval<const %2$s&>().%3$s())>(%4$"PRIu32", next, field);\n",
+                 idl_identifier(declarator), fullname, name, i)
+         || putf(load, "      case %2$"PRIu32": return filter_load(sample.%1$s());\n", name, i))
+          return IDL_RETCODE_NO_MEMORY;
+      } else if (idl_is_struct(ts)) {
+        if (member->key.value)
+          *keyable = false;
+        if (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, ts, gen) < 0
+         || putf(resolve, "    if (member == \"%1$s\")\n"
+                          "      return filter_resolve_nested<%2$s>(%3$"PRIu32", name, next, field);\n",
+                 idl_identifier(declarator), type, i)
+         || putf(load, "      case %3$"PRIu32": return filter_members<%2$s>::load(sample.%1$s(), path + 1);\n", name, type, i))
+          return IDL_RETCODE_NO_MEMORY;
+      } else if (member->key.value) {
+        *keyable = false;
+      }
+    }
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+/* prints the member lookup for filter expressions on _struct */
+static idl_retcode_t
+print_filter(const idl_pstate_t *pstate, struct streams *streams, const idl_struct_t *_struct, const char *fullname)
+{
+  static const char *fmt =
+    "template<>\n"
+    "struct filter_members<%1$s> {\n"
+    "  static bool resolve(const std::string &member, const std::string &name, size_t next, filter_field &field) {\n"
+    "    (void)name;\n"
+    "    (void)next;\n"
+    "    (void)field;\n"
+    "%2$s"
+    "    return false;\n"
+    "  }\n\n"
+    "  static filter_value load(const %1$s &sample, const size_t *path) {\n"
+    "    (void)sample;\n"
+    "    switch (*path) {\n"
+    "%3$s"
+    "      default: return filter_value();\n"
+    "    }\n"
+    "  }\n\n"
+    "  static bool store(%1$s &sample, const size_t *path, const filter_value &value) {\n"
+    "    (void)sample;\n"
+    "    (void)value;\n"
+    "    switch (*path) {\n"
+    "%4$s"
+    "      default: return false;\n"
+    "    }\n"
+    "  }\n\n"
+    "  static size_t keys() {\n"
+    "    return %5$"PRIu32";\n"
+    "  }\n"
+    "};\n\n";
+
+  idl_retcode_t ret = IDL_RETCODE_OK;
+  idl_buffer_t resolve, load, store;
+  uint32_t index = 0, keys = 0;
+  /* with a keylist the @key annotations are not used */
+  bool keyable = !(pstate->config.flags & IDL_FLAG_KEYLIST);
+
+  memset(&resolve, 0, sizeof(resolve));
+  memset(&load, 0, sizeof(load));
+  memset(&store, 0, sizeof(store));
+
+  if ((ret = print_filter_members(&resolve, &load, &store, _struct, fullname, streams->generator, &index, &keys, &keyable)) == IDL_RETCODE_OK
+   && idl_fprintf(streams->generator->header.handle, fmt, fullname,
+                  resolve.data ? resolve.data : "", load.data ? load.data : "",
+                  store.data ? store.data : "", keyable ? keys : 0) < 0)
+    ret = IDL_RETCODE_NO_MEMORY;
+
+  if (resolve.data)
+    free(resolve.data);
+  if (load.data)
+    free(load.data);
+  if (store.data)
+    free(store.data);
+
+  return ret;
+}
+
 static idl_retcode_t
 process_struct(
   const idl_pstate_t* pstate,
@@ -1261,7 +1819,9 @@ process_struct(
   if (revisit) {
     if (print_switchbox_close(user_data)
      || print_constructed_type_close(user_data, node)
-     || (!is_nested(node) && print_entry_point_functions(streams, fullname)))
+     || (!is_nested(node) && print_entry_point_functions(streams, fullname))
+     || print_view(pstate, streams, node, fullname)
+     || print_filter(pstate, streams, node, fullname))
       return IDL_RETCODE_NO_MEMORY;
 
     return flush(streams->generator, streams);
@@ -1269,6 +1829,7 @@ process_struct(
 
     idl_retcode_t ret = IDL_RETCODE_OK;
     if ((ret = print_constructed_type_open(user_data, node))
+     || (ret = process_struct_straight_line(pstate, revisit, path, node, streams))
      || (ret = print_switchbox_open(user_data))
      || (ret = process_struct_contents(pstate, revisit, path, node, streams)))
       return ret;